@@ -1,6 +1,8 @@
 #include "addressSpace.hpp"
+#include <algorithm>
 #include <iostream>
 #include <iterator>
+#include <utility>
 
 bool AddressSpace::getBootromState() const {
 	return bootromLoaded;
@@ -8,10 +10,12 @@ bool AddressSpace::getBootromState() const {
 
 void AddressSpace::unmapBootrom() {
 	bootromLoaded = false;
+	mapReadPages(0x0000, BOOTROM_SIZE, memoryLayout.romBank0);
 }
 
 void AddressSpace::mapBootrom() {
 	bootromLoaded = true;
+	mapReadPages(0x0000, BOOTROM_SIZE, bootrom);
 }
 
 void AddressSpace::loadBootrom(const std::string& filename) {
@@ -44,24 +48,465 @@ void AddressSpace::loadGame(const std::string& filename) {
 	const std::streampos rom_size = rom.tellg();
 	rom.seekg(0, std::ios::beg);
 
-	game.reserve(rom_size);
-	game.insert(game.begin(),
-	            std::istream_iterator<Byte>(rom),
-	            std::istream_iterator<Byte>());
+	//forks keep the ROM they were made with
+	game = std::make_shared<std::vector<Byte>>();
+	game->reserve(rom_size);
+	game->insert(game->begin(),
+	             std::istream_iterator<Byte>(rom),
+	             std::istream_iterator<Byte>());
 
-	memoryLayout.romBank0 = game.data();
-	memoryLayout.romBankSwitch = game.data() + ROM_BANK_SIZE;
+	romHash = 1469598103934665603ULL;
+	for (const Byte value : *game) {
+		romHash ^= value;
+		romHash *= 1099511628211ULL;
+	}
+
+	memoryLayout.romBank0 = game->data();
+	memoryLayout.romBankSwitch = game->data() + ROM_BANK_SIZE;
+	mapMemory();
 }
 
 void AddressSpace::dmaTransfer() {
-	dmaTransferRequested = false;
 	const Word addr = memoryLayout.DMA << 8;
-	for (int i = 0; i < 0xA0; i++) {
-		const Byte data = (*this)[addr + i];;
-		(*this)[0xFE00 + i] = data;
-	}
+	for (int i = 0; i < 0xA0; i++)
+		memoryLayout.oam[i] = std::as_const(*this)[addr + i];
 }
 
 void AddressSpace::setTesting(const bool state) {
 	testing = state;
+	if (testing && !testRam)
+		testRam = std::make_unique<Byte[]>(0x10000);
+	mapMemory();
+}
+
+void AddressSpace::fork(AddressSpace& parent) {
+	bootromLoaded = parent.bootromLoaded;
+	std::copy_n(parent.bootrom, BOOTROM_SIZE, bootrom);
+	game = parent.game;
+	testing = parent.testing;
+	if (parent.testRam) {
+		testRam = std::make_unique_for_overwrite<Byte[]>(0x10000);
+		std::copy_n(parent.testRam.get(), 0x10000, testRam.get());
+	}
+	vramBlock = parent.vramBlock;
+	workRamBlocks[0] = parent.workRamBlocks[0];
+	workRamBlocks[1] = parent.workRamBlocks[1];
+	cartridgeRamBanks = parent.cartridgeRamBanks;
+	cartridgeRamBankSize = parent.cartridgeRamBankSize;
+	//registers, OAM and pointers into the shared ROM and blocks
+	memoryLayout = parent.memoryLayout;
+	//the contents are the same so the page hashes still hold
+	std::copy_n(parent.blockGenerations, BLOCK_PAGES, blockGenerations);
+	cartridgeRamGenerations = parent.cartridgeRamGenerations;
+	pageHashes = parent.pageHashes;
+	hashedGenerations = parent.hashedGenerations;
+	ramHash = parent.ramHash;
+
+	MBC = parent.MBC;
+	romSize = parent.romSize;
+	romBanks = parent.romBanks;
+	externalRamSize = parent.externalRamSize;
+	externalRamBanks = parent.externalRamBanks;
+	romHash = parent.romHash;
+	mbcController = MBCController::create(MBC, romBanks, externalRamBanks);
+	mbcController->loadState(parent.mbcController->saveState());
+
+	mapMemory();
+	parent.mapMemory();
+}
+
+Byte* AddressSpace::writable(const std::shared_ptr<Byte[]>& block) {
+	return block.use_count() == 1 ? block.get() : nullptr;
+}
+
+Byte* AddressSpace::owned(std::shared_ptr<Byte[]>& block, const uint32_t size) {
+	if (block.use_count() > 1)
+		block = std::make_shared_for_overwrite<Byte[]>(size);
+	return block.get();
+}
+
+bool AddressSpace::unshare(const Word address) {
+	std::shared_ptr<Byte[]>* block;
+	uint32_t size;
+	if (address < 0xA000) {
+		block = &vramBlock;
+		size = VRAM_SIZE;
+	}
+	else if (address < 0xC000) {
+		//disabled or missing cartridge RAM
+		if (!memoryLayout.externalRam)
+			return false;
+		block = &cartridgeRamBanks[mbcController->ramBank];
+		size = cartridgeRamBankSize;
+	}
+	else {
+		//0xC000 and 0xE000 echo the first bank, 0xD000 and 0xF000 the second
+		block = &workRamBlocks[(address >> 12) & 1];
+		size = WORK_RAM_BANK_SIZE;
+	}
+
+	if (block->use_count() > 1) {
+		auto copy = std::make_shared_for_overwrite<Byte[]>(size);
+		std::copy_n(block->get(), size, copy.get());
+		*block = std::move(copy);
+	}
+	mapBlocks();
+	loadRamBank();
+	mapMemory();
+	return true;
+}
+
+//memoryLayout's pointers to the RAM blocks, after any of them was replaced
+void AddressSpace::mapBlocks() {
+	memoryLayout.vram = vramBlock.get();
+	memoryLayout.memoryBank1 = workRamBlocks[0].get();
+	memoryLayout.memoryBank2 = workRamBlocks[1].get();
+}
+
+void AddressSpace::mapReadPages(const Word start, const uint32_t size, const Byte* memory) {
+	if (testing)
+		return;
+	for (uint32_t offset = 0; offset < size; offset += 0x100)
+		readPages[(start + offset) >> 8] = memory ? memory + offset : nullptr;
+}
+
+void AddressSpace::mapWritePages(const Word start, const uint32_t size, Byte* memory, uint32_t* generations) {
+	if (testing)
+		return;
+	for (uint32_t offset = 0; offset < size; offset += 0x100) {
+		writePages[(start + offset) >> 8] = memory ? memory + offset : nullptr;
+		writeGenerations[(start + offset) >> 8] = memory ? generations + (offset >> 8) : &unmappedGeneration;
+	}
+}
+
+//rebuilds both page tables from the current banks, only needed when the whole layout changes
+void AddressSpace::mapMemory() {
+	if (testing) {
+		//flat 64 KiB with no side effects
+		for (int page = 0; page < 0x100; page++) {
+			readPages[page] = testRam.get() + (page << 8);
+			writePages[page] = testRam.get() + (page << 8);
+			writeGenerations[page] = &unmappedGeneration;
+		}
+		return;
+	}
+	std::fill_n(readPages, 0x100, nullptr);
+	std::fill_n(writePages, 0x100, nullptr);
+	std::fill_n(writeGenerations, 0x100, &unmappedGeneration);
+
+	//0x0000-0x7FFF writes are MBC control so only reads are mapped
+	mapReadPages(0x0000, ROM_BANK_SIZE, memoryLayout.romBank0);
+	if (bootromLoaded)
+		mapReadPages(0x0000, BOOTROM_SIZE, bootrom);
+	mapReadPages(0x4000, ROM_BANK_SIZE, memoryLayout.romBankSwitch);
+	mapReadPages(0x8000, VRAM_SIZE, memoryLayout.vram);
+	mapWritePages(0x8000, VRAM_SIZE, writable(vramBlock), blockGenerations);
+	mapExternalRam();
+	uint32_t* bank1Generations = blockGenerations + (VRAM_SIZE >> 8);
+	uint32_t* bank2Generations = bank1Generations + (WORK_RAM_BANK_SIZE >> 8);
+	mapReadPages(0xC000, WORK_RAM_BANK_SIZE, memoryLayout.memoryBank1);
+	mapWritePages(0xC000, WORK_RAM_BANK_SIZE, writable(workRamBlocks[0]), bank1Generations);
+	mapReadPages(0xD000, WORK_RAM_BANK_SIZE, memoryLayout.memoryBank2);
+	mapWritePages(0xD000, WORK_RAM_BANK_SIZE, writable(workRamBlocks[1]), bank2Generations);
+	//echo ram
+	mapReadPages(0xE000, WORK_RAM_BANK_SIZE, memoryLayout.memoryBank1);
+	mapWritePages(0xE000, WORK_RAM_BANK_SIZE, writable(workRamBlocks[0]), bank1Generations);
+	mapReadPages(0xF000, 0xE00, memoryLayout.memoryBank2);
+	mapWritePages(0xF000, 0xE00, writable(workRamBlocks[1]), bank2Generations);
+}
+
+void AddressSpace::mapExternalRam() {
+	//MBC2 only has 512 bytes, anything past the end of the bank goes down the slow path
+	const uint32_t mappedSize = memoryLayout.externalRam ? cartridgeRamBankSize : 0;
+	mapReadPages(0xA000, RAM_BANK_SIZE, nullptr);
+	mapWritePages(0xA000, RAM_BANK_SIZE, nullptr, nullptr);
+	mapReadPages(0xA000, mappedSize & ~0xFF, memoryLayout.externalRam);
+	if (memoryLayout.externalRam)
+		mapWritePages(0xA000, mappedSize & ~0xFF, writable(cartridgeRamBanks[mbcController->ramBank]),
+		              cartridgeRamGenerations.data() + mbcController->ramBank * (cartridgeRamBankSize >> 8));
+}
+
+Byte AddressSpace::readSlow(const Word address) const {
+	if (address >= 0xFF80) {
+		if (address < 0xFFFF)
+			return memoryLayout.specialRam[address - 0xFF80];
+		//0xFFFF
+		return memoryLayout.IE;
+	}
+	//unmapped rom or cartridge ram
+	if (address < 0xFE00)
+		return 0xFF;
+	if (address < 0xFEA0)
+		return memoryLayout.oam[address - 0xFE00];
+	if (address < 0xFF00) {
+		if ((memoryLayout.STAT & 0x03) == 2 || (memoryLayout.STAT & 0x03) == 3)
+			return 0xFF;
+		return 0x00;
+	}
+	switch (address) {
+	case 0xFF00:
+		return memoryLayout.JOYP;
+	case 0xFF01:
+		return memoryLayout.SB;
+	case 0xFF02:
+		return memoryLayout.SC;
+	case 0xFF04:
+		return memoryLayout.DIV;
+	case 0xFF05:
+		return memoryLayout.TIMA;
+	case 0xFF06:
+		return memoryLayout.TMA;
+	case 0xFF07:
+		return memoryLayout.TAC | 0xF8;;
+	case 0xFF0F:
+		return memoryLayout.IF | 0xE0;
+	case 0xFF10:
+		return memoryLayout.NR10;
+	case 0xFF11:
+		return memoryLayout.NR11;
+	case 0xFF12:
+		return memoryLayout.NR12;
+	case 0xFF13:
+		return memoryLayout.NR13;
+	case 0xFF14:
+		return memoryLayout.NR14;
+	case 0xFF16:
+		return memoryLayout.NR21;
+	case 0xFF17:
+		return memoryLayout.NR22;
+	case 0xFF18:
+		return memoryLayout.NR23;
+	case 0xFF19:
+		return memoryLayout.NR24;
+	case 0xFF1A:
+		return memoryLayout.NR30;
+	case 0xFF1B:
+		return memoryLayout.NR31;
+	case 0xFF1C:
+		return memoryLayout.NR32;
+	case 0xFF1D:
+		return memoryLayout.NR33;
+	case 0xFF1E:
+		return memoryLayout.NR34;
+	case 0xFF20:
+		return memoryLayout.NR41;
+	case 0xFF21:
+		return memoryLayout.NR42;
+	case 0xFF22:
+		return memoryLayout.NR43;
+	case 0xFF23:
+		return memoryLayout.NR44;
+	case 0xFF24:
+		return memoryLayout.NR50;
+	case 0xFF25:
+		return memoryLayout.NR51;
+	case 0xFF26:
+		return memoryLayout.NR52;
+	// PPU registers
+	case 0xFF40:
+		return memoryLayout.LCDC;
+	case 0xFF41:
+		return memoryLayout.STAT;
+	case 0xFF42:
+		return memoryLayout.SCY;
+	case 0xFF43:
+		return memoryLayout.SCX;
+	case 0xFF44:
+		//for debugging only
+		//return 0x90;
+		return memoryLayout.LY;
+	case 0xFF45:
+		return memoryLayout.LYC;
+	case 0xFF46:
+		return memoryLayout.DMA;
+	case 0xFF47:
+		return memoryLayout.BGP;
+	case 0xFF48:
+		return memoryLayout.OBP0;
+	case 0xFF49:
+		return memoryLayout.OBP1;
+	case 0xFF4A:
+		return memoryLayout.WY;
+	case 0xFF4B:
+		return memoryLayout.WX;
+	default:
+		if (address >= 0xFF30 && address <= 0xFF3F) {
+			return memoryLayout.waveRam[address - 0xFF30];
+		}
+		return 0xFF;
+	}
+}
+
+void AddressSpace::writeSlow(const Word address, const Byte value) {
+	if (address >= 0xFF80) {
+		if (address < 0xFFFF)
+			memoryLayout.specialRam[address - 0xFF80] = value;
+		else
+			memoryLayout.IE = value;
+		return;
+	}
+	if (address < 0x8000) {
+		if (mbcController->write(address, value)) {
+			loadRomBank();
+			loadRamBank();
+		}
+		return;
+	}
+	//cartridge RAM that's missing or disabled, or a block still shared with a fork
+	if (address < 0xFE00) {
+		if (unshare(address)) {
+			if (Byte* page = writePages[address >> 8]) {
+				page[address & 0xFF] = value;
+				++*writeGenerations[address >> 8];
+			}
+		}
+		return;
+	}
+	if (address < 0xFEA0) {
+		memoryLayout.oam[address - 0xFE00] = value;
+		return;
+	}
+	if (address < 0xFF00) {
+		memoryLayout.notUsable[address - 0xFEA0] = value;
+		return;
+	}
+	switch (address) {
+	case 0xFF00:
+		//only the select bits are writable
+		memoryLayout.JOYP = (memoryLayout.JOYP & 0xCF) | (value & 0x30);
+		break;
+	case 0xFF01:
+		memoryLayout.SB = value;
+		break;
+	case 0xFF02:
+		memoryLayout.SC = value;
+		break;
+	case 0xFF04:
+		//any write resets the divider
+		memoryLayout.DIV = 0;
+		break;
+	// Timer registers
+	case 0xFF05:
+		memoryLayout.TIMA = value;
+		break;
+	case 0xFF06:
+		memoryLayout.TMA = value;
+		break;
+	case 0xFF07:
+		memoryLayout.TAC = value;
+		break;
+	case 0xFF0F:
+		memoryLayout.IF = value;
+		break;
+	case 0xFF10:
+		memoryLayout.NR10 = value;
+		break;
+	case 0xFF11:
+		memoryLayout.NR11 = value;
+		break;
+	case 0xFF12:
+		memoryLayout.NR12 = value;
+		break;
+	case 0xFF13:
+		memoryLayout.NR13 = value;
+		break;
+	case 0xFF14:
+		memoryLayout.NR14 = value;
+		break;
+	case 0xFF16:
+		memoryLayout.NR21 = value;
+		break;
+	case 0xFF17:
+		memoryLayout.NR22 = value;
+		break;
+	case 0xFF18:
+		memoryLayout.NR23 = value;
+		break;
+	case 0xFF19:
+		memoryLayout.NR24 = value;
+		break;
+	case 0xFF1A:
+		memoryLayout.NR30 = value;
+		break;
+	case 0xFF1B:
+		memoryLayout.NR31 = value;
+		break;
+	case 0xFF1C:
+		memoryLayout.NR32 = value;
+		break;
+	case 0xFF1D:
+		memoryLayout.NR33 = value;
+		break;
+	case 0xFF1E:
+		memoryLayout.NR34 = value;
+		break;
+	case 0xFF20:
+		memoryLayout.NR41 = value;
+		break;
+	case 0xFF21:
+		memoryLayout.NR42 = value;
+		break;
+	case 0xFF22:
+		memoryLayout.NR43 = value;
+		break;
+	case 0xFF23:
+		memoryLayout.NR44 = value;
+		break;
+	case 0xFF24:
+		memoryLayout.NR50 = value;
+		break;
+	case 0xFF25:
+		memoryLayout.NR51 = value;
+		break;
+	case 0xFF26:
+		memoryLayout.NR52 = value;
+		break;
+	case 0xFF40:
+		memoryLayout.LCDC = value;
+		break;
+	case 0xFF41:
+		//mode and LYC=LY bits are read only, bit 7 always reads back set
+		memoryLayout.STAT = (memoryLayout.STAT & 0x07) | (value & 0x78) | 0x80;
+		break;
+	case 0xFF42:
+		memoryLayout.SCY = value;
+		break;
+	case 0xFF43:
+		memoryLayout.SCX = value;
+		break;
+	case 0xFF44:
+		//LY is read only
+		break;
+	case 0xFF45:
+		memoryLayout.LYC = value;
+		break;
+	case 0xFF46:
+		memoryLayout.DMA = value;
+		break;
+	case 0xFF47:
+		memoryLayout.BGP = value;
+		break;
+	case 0xFF48:
+		memoryLayout.OBP0 = value;
+		break;
+	case 0xFF49:
+		memoryLayout.OBP1 = value;
+		break;
+	case 0xFF4A:
+		memoryLayout.WY = value;
+		break;
+	case 0xFF4B:
+		memoryLayout.WX = value;
+		break;
+	case 0xFF50:
+		//the bootrom unmaps itself by writing here just before jumping to 0x100
+		if (value)
+			unmapBootrom();
+		break;
+	default:
+		if (address >= 0xFF30 && address <= 0xFF3F) {
+			memoryLayout.waveRam[address - 0xFF30] = value;
+		}
+		break;
+	}
 }
@@ -4,32 +4,83 @@
 #include <filesystem>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "defines.hpp"
+#include "mbc.hpp"
+#include "saveState.hpp"
+#include "stateHash.hpp"
+
+//256 byte pages of VRAM and the two work RAM banks
+#define BLOCK_PAGES ((VRAM_SIZE + 2 * WORK_RAM_BANK_SIZE) >> 8)
 
 class AddressSpace {
 	bool bootromLoaded = true;
 	Byte bootrom[BOOTROM_SIZE] = {0};
-	std::vector<Byte> game;
-	bool testing;
-	Byte testRam[0xFFFF];
-	Byte* cartridgeRam = nullptr;
+	//shared by every fork
+	std::shared_ptr<std::vector<Byte>> game = std::make_shared<std::vector<Byte>>();
+	bool testing = false;
+	//flat 64 KiB, only allocated once testing
+	std::unique_ptr<Byte[]> testRam;
+
+	//RAM is held in blocks that forks share until one of them writes to it. A block's pages are only mapped
+	//for writing while nothing else holds it, the first write after a fork goes down the slow path to unshare()
+	std::shared_ptr<Byte[]> vramBlock; //one block, the PPU reads it as a whole
+	std::shared_ptr<Byte[]> workRamBlocks[2];
+	std::vector<std::shared_ptr<Byte[]>> cartridgeRamBanks;
+	uint32_t cartridgeRamBankSize = 0;
+	static Byte* writable(const std::shared_ptr<Byte[]>& block);
+	//the block itself if nothing else holds it, otherwise a fresh one to be filled in whole
+	static Byte* owned(std::shared_ptr<Byte[]>& block, uint32_t size);
+	//gives this instance its own copy of the block behind address, false if nothing writable is there
+	bool unshare(Word address);
+	void mapBlocks();
+
+	//one entry per 256 byte page pointing at the memory backing it,
+	//nullptr sends the access down the slow path (I/O registers, MBC control, OAM)
+	const Byte* readPages[0x100] = {};
+	Byte* writePages[0x100] = {};
+	//bumped by every write through a page of the RAM blocks so stateHash() only rehashes pages that moved.
+	//VRAM's pages then work RAM's, the cartridge RAM banks have their own
+	uint32_t blockGenerations[BLOCK_PAGES] = {};
+	std::vector<uint32_t> cartridgeRamGenerations;
+	uint32_t unmappedGeneration = 0; //counts writes to memory that isn't a RAM block
+	uint32_t* writeGenerations[0x100] = {};
+	void mapReadPages(Word start, uint32_t size, const Byte* memory);
+	void mapWritePages(Word start, uint32_t size, Byte* memory, uint32_t* generations);
+	//each RAM block page's hash, seeded with its index, and the generation it was taken at. ramHash is their
+	//sum, a page that changed is swapped out of it without touching the rest
+	mutable std::vector<StateHash> pageHashes;
+	mutable std::vector<uint32_t> hashedGenerations;
+	mutable StateHash ramHash = {};
+	size_t ramPages() const;
+	const Byte* ramPage(size_t index) const;
+	void updateRamHash(const uint32_t* generations, size_t first, size_t count) const;
+	void mapMemory();
+	void mapExternalRam();
+	Byte readSlow(Word address) const;
+	void writeSlow(Word address, Byte value);
 
 public:
 	AddressSpace() {
 		// Initialize the memory to zero
 		memoryLayout = {};
+		vramBlock = std::make_shared<Byte[]>(VRAM_SIZE);
+		workRamBlocks[0] = std::make_shared<Byte[]>(WORK_RAM_BANK_SIZE);
+		workRamBlocks[1] = std::make_shared<Byte[]>(WORK_RAM_BANK_SIZE);
+		mapBlocks();
+		mapMemory();
 	}
 
 	struct {
 		Byte* romBank0; //[ROM_BANK_SIZE] Mapped to 0x0000
 		Byte* romBankSwitch; //[ROM_BANK_SIZE] Mapped to 0x4000
-		Byte vram[0x2000]; //Mapped to 0x8000
+		Byte* vram; //[VRAM_SIZE] Mapped to 0x8000
 		Byte* externalRam; //[0x2000]; Mapped to 0xA000
-		Byte memoryBank1[0x1000]; //Mapped to 0xC000
-		Byte memoryBank2[0x1000]; //Mapped to 0xD000
+		Byte* memoryBank1; //[WORK_RAM_BANK_SIZE] Mapped to 0xC000
+		Byte* memoryBank2; //[WORK_RAM_BANK_SIZE] Mapped to 0xD000
 		Byte oam[0xA0]; //Mapped to 0xFE00
 		Byte notUsable[0x60]; //Mapped to 0xFEA0
 		//General purpose hardware registers
@@ -90,13 +141,10 @@ public:
 	bool getBootromState() const;
 	void loadBootrom(const std::string& filename);
 	void loadGame(const std::string& filename);
+	//FNV-1a of the whole ROM, save states refer to the ROM by it
+	uint64_t romHash = 0;
 
 	void determineMBCInfo();
-	static bool testMBCWrite(Word address);
-	Byte* MBCRead(Word address);
-	//prevents seg faults when programs with no MBC try to write to ROM
-	Byte dummyVal = 0;
-	void MBCUpdate();
 	void loadRomBank();
 	void createRamBank();
 	void loadRamBank();
@@ -105,277 +153,38 @@ public:
 	uint32_t romBanks = 0;
 	uint32_t externalRamSize = 0;
 	uint32_t externalRamBanks = 0;
+	std::unique_ptr<MBCController> mbcController = std::make_unique<RomOnlyController>();
 
-	bool dmaTransferRequested = false;
 	void dmaTransfer();
 
-	//Selected ROM Bank = (Secondary Bank << 5) + ROM Bank
-	Byte selectedRomBank = 0;
-	Byte romBankRegister = 0x00;
-	//2 bit register acts as secondary rom bank register or ram bank number
-	Byte twoBitBankRegister = 0x0;
-	Byte selectedExternalRamBank = 0;
-	Byte romRamSelect = 0x00;
-	Byte ramEnable = 0x00;
-	//MBC3
-	Byte latchClockData = 0x00;
-	Byte ramBankRTCRegister = 0x00;
-
 	void setTesting(bool state);
 
+	//takes on parent's ROM, memory and registers, sharing the ROM and RAM blocks copy-on-write with it.
+	//parent stops writing to them in place too until it's the only holder again
+	void fork(AddressSpace& parent);
+
+	//memory, bank registers and cartridge RAM, see saveState.cpp
+	void saveState(StateWriter& state) const;
+	void loadState(StateReader& state);
+	//what saveState() writes with RAM reduced to a hash of its pages, for GameBoy::stateHash()
+	void hashState(StateWriter& state) const;
+
 	//read
 	Byte operator[](const Word address) const {
-		if (testing)
-			return testRam[address];
-		if (address < 0x0100 && bootromLoaded)
-			return bootrom[address];
-		if (address < 0x4000)
-			return memoryLayout.romBank0[address];
-		if (address < 0x8000)
-			return memoryLayout.romBankSwitch[address - 0x4000];
-		if (address < 0xA000)
-			return memoryLayout.vram[address - 0x8000];
-		if (address < 0xC000) {
-			if (externalRamSize == 0)
-				return 0xFF;
-			return memoryLayout.externalRam[address - 0xA000];
-		}
-		if (address < 0xD000)
-			return memoryLayout.memoryBank1[address - 0xC000];
-		if (address < 0xE000)
-			return memoryLayout.memoryBank2[address - 0xD000];
-		if (address < 0xFE00)
-			return memoryLayout.memoryBank1[address - 0xE000];
-		if (address < 0xFEA0)
-			return memoryLayout.oam[address - 0xFE00];
-		if (address < 0xFF00) {
-			if ((memoryLayout.STAT & 0x03) == 2 || (memoryLayout.STAT & 0x03) == 3)
-				return 0xFF;
-			return 0x00;
-		}
-		if (address < 0xFF80)
-			switch (address) {
-			case 0xFF00:
-				return memoryLayout.JOYP;
-			case 0xFF01:
-				return memoryLayout.SB;
-			case 0xFF02:
-				return memoryLayout.SC;
-			case 0xFF04:
-				return memoryLayout.DIV;
-			case 0xFF05:
-				return memoryLayout.TIMA;
-			case 0xFF06:
-				return memoryLayout.TMA;
-			case 0xFF07:
-				return memoryLayout.TAC | 0xF8;;
-			case 0xFF0F:
-				return memoryLayout.IF | 0xE0;
-			case 0xFF10:
-				return memoryLayout.NR10;
-			case 0xFF11:
-				return memoryLayout.NR11;
-			case 0xFF12:
-				return memoryLayout.NR12;
-			case 0xFF13:
-				return memoryLayout.NR13;
-			case 0xFF14:
-				return memoryLayout.NR14;
-			case 0xFF16:
-				return memoryLayout.NR21;
-			case 0xFF17:
-				return memoryLayout.NR22;
-			case 0xFF18:
-				return memoryLayout.NR23;
-			case 0xFF19:
-				return memoryLayout.NR24;
-			case 0xFF1A:
-				return memoryLayout.NR30;
-			case 0xFF1B:
-				return memoryLayout.NR31;
-			case 0xFF1C:
-				return memoryLayout.NR32;
-			case 0xFF1D:
-				return memoryLayout.NR33;
-			case 0xFF1E:
-				return memoryLayout.NR34;
-			case 0xFF20:
-				return memoryLayout.NR41;
-			case 0xFF21:
-				return memoryLayout.NR42;
-			case 0xFF22:
-				return memoryLayout.NR43;
-			case 0xFF23:
-				return memoryLayout.NR44;
-			case 0xFF24:
-				return memoryLayout.NR50;
-			case 0xFF25:
-				return memoryLayout.NR51;
-			case 0xFF26:
-				return memoryLayout.NR52;
-			// PPU registers
-			case 0xFF40:
-				return memoryLayout.LCDC;
-			case 0xFF41:
-				return memoryLayout.STAT;
-			case 0xFF42:
-				return memoryLayout.SCY;
-			case 0xFF43:
-				return memoryLayout.SCX;
-			case 0xFF44:
-				//for debugging only
-				//return 0x90;
-				return memoryLayout.LY;
-			case 0xFF45:
-				return memoryLayout.LYC;
-			case 0xFF46:
-				return memoryLayout.DMA;
-			case 0xFF47:
-				return memoryLayout.BGP;
-			case 0xFF48:
-				return memoryLayout.OBP0;
-			case 0xFF49:
-				return memoryLayout.OBP1;
-			case 0xFF4A:
-				return memoryLayout.WY;
-			case 0xFF4B:
-				return memoryLayout.WX;
-			default:
-				if (address >= 0xFF30 && address <= 0xFF3F) {
-					return memoryLayout.waveRam[address - 0xFF30];
-				}
-				return 0xFF;
-			}
-		if (address < 0xFFFF)
-			return memoryLayout.specialRam[address - 0xFF80];
-		//0xFFFF
-		return memoryLayout.IE;
+		if (const Byte* page = readPages[address >> 8])
+			return page[address & 0xFF];
+		return readSlow(address);
 	}
 
-	//write
-	Byte& operator[](const Word address) {
-		dummyVal = 0xFF;
-		if (testing)
-			return testRam[address];
-		if (address < 0x0100 && bootromLoaded)
-			return bootrom[address];
-		if (address < 0x8000)
-			return (*MBCRead(address));
-		if (address < 0xA000)
-			return memoryLayout.vram[address - 0x8000];
-		if (address < 0xC000) {
-			if (externalRamSize == 0)
-				return dummyVal;
-			return memoryLayout.externalRam[address - 0xA000];
+	//write, only stores the value, I/O side effects that touch CPU/PPU state are applied by GameBoy::write
+	void write(const Word address, const Byte value) {
+		if (Byte* page = writePages[address >> 8]) {
+			page[address & 0xFF] = value;
+			++*writeGenerations[address >> 8];
+		}
+		else {
+			writeSlow(address, value);
 		}
-		if (address < 0xD000)
-			return memoryLayout.memoryBank1[address - 0xC000];
-		if (address < 0xE000)
-			return memoryLayout.memoryBank2[address - 0xD000];
-		if (address < 0xFE00)
-			return memoryLayout.memoryBank1[address - 0xE000];
-		if (address < 0xFEA0)
-			return memoryLayout.oam[address - 0xFE00];
-		if (address < 0xFF00)
-			return memoryLayout.notUsable[address - 0xFEA0];
-		if (address < 0xFF80)
-			switch (address) {
-			case 0xFF00:
-				return memoryLayout.JOYP;
-			case 0xFF01:
-				return memoryLayout.SB;
-			case 0xFF02:
-				return memoryLayout.SC;
-			case 0xFF04:
-				memoryLayout.DIV = 0;
-				return dummyVal;
-			// Timer registers
-			case 0xFF05:
-				return memoryLayout.TIMA;
-			case 0xFF06:
-				return memoryLayout.TMA;
-			case 0xFF07:
-				return memoryLayout.TAC;
-			case 0xFF0F:
-				return memoryLayout.IF;
-			case 0xFF10:
-				return memoryLayout.NR10;
-			case 0xFF11:
-				return memoryLayout.NR11;
-			case 0xFF12:
-				return memoryLayout.NR12;
-			case 0xFF13:
-				return memoryLayout.NR13;
-			case 0xFF14:
-				return memoryLayout.NR14;
-			case 0xFF16:
-				return memoryLayout.NR21;
-			case 0xFF17:
-				return memoryLayout.NR22;
-			case 0xFF18:
-				return memoryLayout.NR23;
-			case 0xFF19:
-				return memoryLayout.NR24;
-			case 0xFF1A:
-				return memoryLayout.NR30;
-			case 0xFF1B:
-				return memoryLayout.NR31;
-			case 0xFF1C:
-				return memoryLayout.NR32;
-			case 0xFF1D:
-				return memoryLayout.NR33;
-			case 0xFF1E:
-				return memoryLayout.NR34;
-			case 0xFF20:
-				return memoryLayout.NR41;
-			case 0xFF21:
-				return memoryLayout.NR42;
-			case 0xFF22:
-				return memoryLayout.NR43;
-			case 0xFF23:
-				return memoryLayout.NR44;
-			case 0xFF24:
-				return memoryLayout.NR50;
-			case 0xFF25:
-				return memoryLayout.NR51;
-			case 0xFF26:
-				return memoryLayout.NR52;
-			case 0xFF40:
-				return memoryLayout.LCDC;
-			case 0xFF41:
-				return memoryLayout.STAT;
-			case 0xFF42:
-				return memoryLayout.SCY;
-			case 0xFF43:
-				return memoryLayout.SCX;
-			case 0xFF44:
-				dummyVal = memoryLayout.LY;
-				return dummyVal;
-			case 0xFF45:
-				return memoryLayout.LYC;
-			case 0xFF46:
-				dmaTransferRequested = true;
-				return memoryLayout.DMA;
-			case 0xFF47:
-				return memoryLayout.BGP;
-			case 0xFF48:
-				return memoryLayout.OBP0;
-			case 0xFF49:
-				return memoryLayout.OBP1;
-			case 0xFF4A:
-				return memoryLayout.WY;
-			case 0xFF4B:
-				return memoryLayout.WX;
-			default:
-				if (address >= 0xFF30 && address <= 0xFF3F) {
-					return memoryLayout.waveRam[address - 0xFF30];
-				}
-				return dummyVal;
-			}
-		if (address < 0xFFFF)
-			return memoryLayout.specialRam[address - 0xFF80];
-		//0xFFFF
-		return memoryLayout.IE;
 	}
 };
 
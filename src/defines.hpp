@@ -29,7 +29,6 @@
 
 #define RESOLUTION_X 160
 #define RESOLUTION_Y 144
-#define SCREEN_BPP 3
 
 //lcdc
 #define BG_WINDOW_ENABLE 0
@@ -50,6 +49,8 @@
 
 #define ROM_BANK_SIZE 0x4000
 #define RAM_BANK_SIZE 0x2000
+#define VRAM_SIZE 0x2000
+#define WORK_RAM_BANK_SIZE 0x1000
 
 #define SCANLINES_PER_FRAME 154
 #define SCANLINE_DURATION 456
@@ -64,6 +65,14 @@
 #define SCANLINE_OAM_FREQ 80 //PPU_MODE 2
 #define SCANLINE_VRAM_FREQ 80 //PPU_MODE 3
 
+//expands X(00) X(01) ... X(FF), used to generate per-opcode labels for threaded dispatch
+#define GBPP_OPCODE_ROW(X, hi) X(hi##0) X(hi##1) X(hi##2) X(hi##3) X(hi##4) X(hi##5) X(hi##6) X(hi##7) \
+	X(hi##8) X(hi##9) X(hi##A) X(hi##B) X(hi##C) X(hi##D) X(hi##E) X(hi##F)
+#define GBPP_OPCODE_LIST(X) GBPP_OPCODE_ROW(X, 0) GBPP_OPCODE_ROW(X, 1) GBPP_OPCODE_ROW(X, 2) GBPP_OPCODE_ROW(X, 3) \
+	GBPP_OPCODE_ROW(X, 4) GBPP_OPCODE_ROW(X, 5) GBPP_OPCODE_ROW(X, 6) GBPP_OPCODE_ROW(X, 7) \
+	GBPP_OPCODE_ROW(X, 8) GBPP_OPCODE_ROW(X, 9) GBPP_OPCODE_ROW(X, A) GBPP_OPCODE_ROW(X, B) \
+	GBPP_OPCODE_ROW(X, C) GBPP_OPCODE_ROW(X, D) GBPP_OPCODE_ROW(X, E) GBPP_OPCODE_ROW(X, F)
+
 #define WHITE 0xFFFFFFFF;
 #define LIGHT_GRAY 0xFFAAAAAA;
 #define DARK_GRAY 0xFF555555;
@@ -118,4 +127,20 @@ enum PPUMode {
 	mode3 // Pixel Transfer (Mode 3): Access to both OAM and video RAM, actual pixel transfer to the screen.
 };
 
+//which frames drawLine() produces pixels for, PPU timing and interrupts are the same either way
+enum RenderPolicy {
+	renderAll,
+	renderEveryNth, //first frame of every interval
+	renderOnRequest //one frame per requestRender()
+};
+
+//what the framebuffer holds for each pixel, rows are packed with no padding
+enum PixelFormat {
+	pixelARGB8888,
+	pixelRGB565,
+	pixelGray8, //0xFF white to 0x00 black
+	pixelShade8, //the palette's output shade, 0 white to 3 black
+	pixelShade2 //the same shades 4 to a byte, leftmost pixel in the top bits
+};
+
 #endif
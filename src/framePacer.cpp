@@ -0,0 +1,46 @@
+#include <thread>
+#include "defines.hpp"
+#include "framePacer.hpp"
+
+//70224 T-cycles at 4.194304 MHz, ~16.74ms
+static constexpr double FRAME_SECONDS = static_cast<double>(FRAME_DURATION) / T_CLOCK_FREQ;
+//sleep until this close to the deadline then spin, sleeps routinely overshoot by more than the error we want
+static constexpr std::chrono::microseconds SPIN_THRESHOLD(1000);
+//more than this many frames behind (host too slow, window dragged, debugger) and the debt is dropped rather
+//than running flat out to catch up
+static constexpr uint64_t MAX_FRAMES_BEHIND = 4;
+
+void FramePacer::setMode(const PacingMode newMode, const double newSpeed) {
+	mode = newMode;
+	speed = newMode == multipliedPacing && newSpeed > 0 ? newSpeed : 1.0;
+	epoch = Clock::now();
+	frames = 0;
+}
+
+FramePacer::Clock::time_point FramePacer::deadline() const {
+	const std::chrono::duration<double> offset(frames * FRAME_SECONDS / speed);
+	return epoch + std::chrono::duration_cast<Clock::duration>(offset);
+}
+
+void FramePacer::wait() {
+	if (mode == unthrottledPacing)
+		return;
+
+	frames++;
+	const Clock::time_point due = deadline();
+	Clock::time_point now = Clock::now();
+
+	if (now > due) {
+		const std::chrono::duration<double> behind = now - due;
+		if (behind.count() > MAX_FRAMES_BEHIND * FRAME_SECONDS / speed) {
+			epoch = now;
+			frames = 0;
+		}
+		return;
+	}
+
+	if (due - now > SPIN_THRESHOLD)
+		std::this_thread::sleep_until(due - SPIN_THRESHOLD);
+	while (Clock::now() < due)
+		std::this_thread::yield();
+}
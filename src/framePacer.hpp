@@ -0,0 +1,36 @@
+#ifndef GBPP_SRC_FRAMEPACER_HPP_
+#define GBPP_SRC_FRAMEPACER_HPP_
+
+#include <chrono>
+#include <cstdint>
+
+enum PacingMode {
+	unthrottledPacing, //run as fast as the host allows
+	realTimePacing, //59.73 Hz, the DMG's actual frame rate
+	multipliedPacing //a multiple of real time, for fast forward
+};
+
+//Keeps emulated frames in step with wall clock time. Frames are due at fixed offsets from when pacing started
+//rather than a delay after the previous one, so oversleeping on one frame is made up on the next instead of
+//accumulating
+class FramePacer {
+	using Clock = std::chrono::steady_clock;
+
+	PacingMode mode = realTimePacing;
+	double speed = 1.0;
+	Clock::time_point epoch = Clock::now();
+	uint64_t frames = 0;
+
+	Clock::time_point deadline() const;
+
+public:
+	//speed is only used by multipliedPacing
+	void setMode(PacingMode newMode, double newSpeed = 1.0);
+	PacingMode getMode() const { return mode; }
+	double getSpeed() const { return speed; }
+
+	//call once per emulated frame, blocks until that frame is due
+	void wait();
+};
+
+#endif //GBPP_SRC_FRAMEPACER_HPP_
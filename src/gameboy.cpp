@@ -1,12 +1,98 @@
+#include <cstdio>
 #include <iostream>
 #include "gameboy.hpp"
 
-void GameBoy::addCycles(const uint8_t ticks) {
+void GameBoy::addCycles(const uint64_t ticks) {
 	cycles += ticks;
 	if (ppuEnabled) {
 		ppuCycles += ticks;
 	}
-	lastOpTicks = ticks;
+}
+
+Byte GameBoy::read(const Word address) {
+	//DIV and TIMA are only caught up when something looks at them
+	if ((address & 0xFFFE) == 0xFF04) {
+		timingHandler();
+		loopSideEffects++;
+	}
+	return readOnlyAddressSpace[address];
+}
+
+void GameBoy::write(const Word address, const Byte value) {
+#ifdef GBPP_PIXEL_FIFO_PPU
+	//pixels up to this dot are drawn with what was there before
+	if (fifo.active && ((address >= 0x8000 && address < 0xA000) || (address >= 0xFE00 && address < 0xFEA0) ||
+		(address & 0xFFF0) == 0xFF40))
+		fifoCatchUp();
+#endif
+	//catch the timer up before its registers change under it
+	if ((address & 0xFFFC) == 0xFF04)
+		timingHandler();
+	//and draw lines still waiting on VRAM/OAM before they change
+	else if ((address >= 0x8000 && address < 0xA000) || (address >= 0xFE00 && address < 0xFEA0))
+		renderPendingLines();
+	addressSpace.write(address, value);
+	loopSideEffects++;
+	if ((address >> 8) == 0xFF) {
+		if (const auto hook = ioWriteHooks[address & 0xFF])
+			(this->*hook)();
+	}
+	else if (address >= 0x8000 && address < 0x9800) {
+		tileCache.invalidate(address);
+	}
+	else if (address >= 0xFE00 && address < 0xFEA0) {
+		objectIndex.write(addressSpace.memoryLayout.oam, address - 0xFE00);
+	}
+}
+
+const GameBoy::IOWriteHooks GameBoy::ioWriteHooks = [] {
+	IOWriteHooks hooks = {};
+	hooks[0x00] = &GameBoy::joypadHandler;
+	hooks[0x04] = &GameBoy::DIVWrite;
+	hooks[0x05] = &GameBoy::scheduleTimer;
+	hooks[0x06] = &GameBoy::TMAWrite;
+	hooks[0x07] = &GameBoy::TACWrite;
+	hooks[0x0F] = &GameBoy::scheduleInterruptCheck;
+	hooks[0x40] = &GameBoy::LCDCWrite;
+	hooks[0x41] = &GameBoy::STATWrite;
+	hooks[0x45] = &GameBoy::STATWrite;
+	hooks[0x46] = &GameBoy::DMAWrite;
+	hooks[0xFF] = &GameBoy::scheduleInterruptCheck;
+	return hooks;
+}();
+
+void GameBoy::DMAWrite() {
+	//a new write restarts the transfer
+	scheduler.schedule(dmaEvent, cycles + 160);
+}
+
+//everything that used to be polled after each instruction, now only run at boundaries where an event is due.
+//Each handler is a no-op when nothing changed so it's safe to run them all whichever event fired
+void GameBoy::serviceEvents() {
+	timingHandler();
+	interruptHandler();
+	if (ppuEnabled) {
+		ppuUpdate();
+	}
+	if (setIME) {
+		IME = 1;
+		setIME = false;
+	}
+	if (IME_togge) {
+		setIME = true;
+		IME_togge = false;
+	}
+	if (scheduler.due(dmaEvent, cycles)) {
+		scheduler.cancel(dmaEvent);
+		renderPendingLines();
+		addressSpace.dmaTransfer();
+		objectIndex.rebuild(addressSpace.memoryLayout.oam);
+	}
+	//TIMA reloads from TMA as it was before the instruction that overflowed it, TMA writes force a service
+	//so this is always that value
+	prevTMA = addressSpace.memoryLayout.TMA;
+	scheduleInterruptCheck();
+	loopSideEffects++;
 }
 
 GameboyTestState GameBoy::runTest(GameboyTestState initial) {
@@ -25,14 +111,14 @@ GameboyTestState GameBoy::runTest(GameboyTestState initial) {
 	addressSpace.memoryLayout.IE = 1;
 
 	for (const auto& [addr, val] : initial.RAM) {
-		addressSpace[addr] = val;
+		addressSpace.write(addr, val);
 	}
 
 	opcodeResolver();
 
 	std::vector<std::tuple<Word, Byte>> returnRAM;
 	for (const auto& [addr, val] : initial.RAM) {
-		returnRAM.emplace_back(addr, addressSpace[addr]);
+		returnRAM.emplace_back(addr, readOnlyAddressSpace[addr]);
 	}
 	return {
 		PC, SP,
@@ -45,158 +131,85 @@ GameboyTestState GameBoy::runTest(GameboyTestState initial) {
 }
 
 
-void GameBoy::start(const std::string& bootrom, const std::string& game) {
-	addressSpace.loadBootrom(bootrom);
-	addressSpace.loadGame(game);
+void GameBoy::loadBootrom(const std::string& path) {
+	addressSpace.loadBootrom(path);
+}
+
+void GameBoy::loadGame(const std::string& path) {
+	addressSpace.loadGame(path);
 	addressSpace.determineMBCInfo();
 	addressSpace.createRamBank();
+}
 
-	bool quit = false;
-	bool setIME = false;
-	bool debug = false;
-	bool step = false;
-
-	while (!quit) {
-		// Event loop
-		while (SDL_PollEvent(&event)) {
-			switch (event.type) {
-			case SDL_QUIT:
-				quit = true;
-				break;
-			case SDL_KEYDOWN:
-				switch (event.key.keysym.sym) {
-				case SDLK_a:
-					joypadInput.LEFT = true;
-					break;
-				case SDLK_d:
-					joypadInput.RIGHT = true;
-					break;
-				case SDLK_w:
-					joypadInput.UP = true;
-					break;
-				case SDLK_s:
-					joypadInput.DOWN = true;
-					break;
-				case SDLK_k:
-					joypadInput.A = true;
-					break;
-				case SDLK_l:
-					joypadInput.B = true;
-					break;
-				case SDLK_o:
-					joypadInput.SELECT = true;
-					break;
-				case SDLK_p:
-					joypadInput.START = true;
-					break;
-				case SDLK_h:
-					debug = !debug;
-					break;
-				case SDLK_n:
-					step = true;
-					break;
-				default:
-					break;
-				}
-				break;
-			case SDL_KEYUP:
-				switch (event.key.keysym.sym) {
-				case SDLK_a:
-					joypadInput.LEFT = false;
-					break;
-				case SDLK_d:
-					joypadInput.RIGHT = false;
-					break;
-				case SDLK_w:
-					joypadInput.UP = false;
-					break;
-				case SDLK_s:
-					joypadInput.DOWN = false;
-					break;
-				case SDLK_k:
-					joypadInput.A = false;
-					break;
-				case SDLK_l:
-					joypadInput.B = false;
-					break;
-				case SDLK_o:
-					joypadInput.SELECT = false;
-					break;
-				case SDLK_p:
-					joypadInput.START = false;
-					break;
-				default:
-					break;
-				}
-				break;
-			default:
-				break;
-			}
+void GameBoy::runFrame() {
+	//no frame ever finishes with the LCD off, so stop after a frame's worth of cycles and let the caller pace
+	const uint64_t limit = cycles + FRAME_DURATION;
+	scheduler.schedule(stopEvent, limit);
+	rendered = false;
+	while (!rendered && (ppuEnabled || cycles < limit)) {
+		runInstructions(false);
+		if (cycles >= scheduler.nextEvent()) {
+			//the LCD came on partway through, so this runs on to VBlank. A stop left due would end every run of
+			//instructions after one and keep HALT and idle loop skipping from jumping ahead
+			if (ppuEnabled && scheduler.due(stopEvent, cycles))
+				scheduler.cancel(stopEvent);
+			serviceEvents();
 		}
+	}
+	scheduler.cancel(stopEvent);
+}
 
-		while (!rendered) {
-			if (debug == true && step == false)
-				break;
-			step = false;
-			joypadHandler();
-			if (PC > 0xFF && addressSpace.getBootromState()) {
-				addressSpace.unmapBootrom();
-			}
-			ppuEnabled = addressSpace.memoryLayout.LCDC & 0x80;
-			prevTMA = addressSpace.memoryLayout.TMA;
-
-			if (debug) {
-				printf(
-					"A: %.2X F: %.2X B: %.2X C: %.2X D: %.2X E: %.2X H: %.2X L: %.2X SP: %.4X PC: 00:%.4X (%.2X %.2X %.2X %.2X)\n",
-					AF.hi, AF.lo, BC.hi, BC.lo, DE.hi, DE.lo, HL.hi, HL.lo, SP, PC, readOnlyAddressSpace[PC],
-					readOnlyAddressSpace[PC + 1], readOnlyAddressSpace[PC + 2], readOnlyAddressSpace[PC + 3]);
-
-
-				// printf("Cycles: %lu, Opcode: 0x%.2x PPU cycles: %lu, PPMode: %d\n", cycles, readOnlyAddressSpace[PC],
-				//        cyclesSinceLastScanline(), currentMode);
-				// printf("AF:0x%.4x, BC:0x%.4x\n", AF.reg, BC.reg);
-				// printf("DE:0x%.4x, HL:0x%.4x\n", DE.reg, HL.reg);
-				// printf("IME:%d IF:0x%.2x IE:0x%.2x\n", IME, (*IF), (*IE));
-				// printf("PC:0x%.4x, SP:0x%.4x\n", PC, SP);
-				// printf("LCDC:%.2x STAT:0x%.2x LY:%d LYC:%d\n", (*LCDC), (*STAT), (*LY), (*LYC));
-				// printf("\n");
-			}
-
-			if (!halted) {
-				opcodeResolver();
-				addressSpace.MBCUpdate();
-			}
-			else {
-				addCycles(4);
-			}
-			timingHandler();
-			interruptHandler();
-			if (ppuEnabled) {
-				ppuUpdate();
-			}
-			else {
-				ppuCycles = 2;
-				lastScanline = 0;
-				lastRefresh = 0;
-				addressSpace.memoryLayout.LY = 0x00;
-				addressSpace.memoryLayout.STAT &= 0xfc;
-			}
-			if (setIME) {
-				IME = 1;
-				setIME = false;
-			}
-			if (IME_togge) {
-				setIME = true;
-				IME_togge = false;
-			}
-			if (addressSpace.dmaTransferRequested) {
-				cyclesUntilDMATransfer -= lastOpTicks;
-				if (cyclesUntilDMATransfer <= 0) {
-					cyclesUntilDMATransfer = 160;
-					addressSpace.dmaTransfer();
-				}
-			}
+void GameBoy::runCycles(const uint64_t ticks) {
+	const uint64_t limit = cycles + ticks;
+	scheduler.schedule(stopEvent, limit);
+	while (cycles < limit) {
+		runInstructions(false);
+		if (cycles >= scheduler.nextEvent()) {
+			serviceEvents();
 		}
-		rendered = false;
 	}
+	scheduler.cancel(stopEvent);
+}
+
+bool GameBoy::step() {
+	rendered = false;
+	runInstructions(true);
+	if (cycles >= scheduler.nextEvent()) {
+		serviceEvents();
+	}
+	return rendered;
+}
+
+void GameBoy::printState() const {
+	printf(
+		"A: %.2X F: %.2X B: %.2X C: %.2X D: %.2X E: %.2X H: %.2X L: %.2X SP: %.4X PC: 00:%.4X (%.2X %.2X %.2X %.2X)\n",
+		AF.hi, AF.lo, BC.hi, BC.lo, DE.hi, DE.lo, HL.hi, HL.lo, SP, PC, readOnlyAddressSpace[PC],
+		readOnlyAddressSpace[PC + 1], readOnlyAddressSpace[PC + 2], readOnlyAddressSpace[PC + 3]);
+
+
+	// printf("Cycles: %lu, Opcode: 0x%.2x PPU cycles: %lu, PPMode: %d\n", cycles, readOnlyAddressSpace[PC],
+	//        cyclesSinceLastScanline(), currentMode);
+	// printf("AF:0x%.4x, BC:0x%.4x\n", AF.reg, BC.reg);
+	// printf("DE:0x%.4x, HL:0x%.4x\n", DE.reg, HL.reg);
+	// printf("IME:%d IF:0x%.2x IE:0x%.2x\n", IME, (*IF), (*IE));
+	// printf("PC:0x%.4x, SP:0x%.4x\n", PC, SP);
+	// printf("LCDC:%.2x STAT:0x%.2x LY:%d LYC:%d\n", (*LCDC), (*STAT), (*LY), (*LYC));
+	// printf("\n");
+}
+
+void GameBoy::setInput(const Input& input) {
+	joypadInput = input;
+	joypadHandler();
+}
+
+std::span<const Byte> GameBoy::getFramebuffer() {
+	renderPendingLines();
+	return framebuffer;
+}
+
+LineMask GameBoy::takeDirtyLines() {
+	renderPendingLines();
+	const LineMask lines = dirtyLines;
+	dirtyLines.reset();
+	return lines;
 }
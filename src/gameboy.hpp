@@ -1,13 +1,21 @@
 #ifndef GBPP_SRC_GAMEBOY_HPP_
 #define GBPP_SRC_GAMEBOY_HPP_
 
+#include <array>
+#include <bitset>
 #include <filesystem>
 #include <cstdint>
+#include <memory>
+#include <span>
 #include <string>
-#include <SDL.h>
+#include <vector>
 #include "defines.hpp"
 #include "addressSpace.hpp"
+#include "scheduler.hpp"
 #include "testing.hpp"
+#include "lineSpans.hpp"
+#include "objectIndex.hpp"
+#include "tileCache.hpp"
 
 union RegisterPair {
 	Word reg; //register.reg == (hi << 8) + lo. (hi is more significant than lo)
@@ -21,10 +29,10 @@ union RegisterPair {
 class GameBoy {
 	//T-cycles not M-cycles (4 T-cycles = 1 M-cycle)
 	uint64_t cycles = 0;
+	Scheduler scheduler;
 	//Start at 2 T-cycles https://github.com/Gekkio/mooneye-test-suite/blob/main/acceptance/ppu/lcdon_timing-GS.s
 	uint64_t ppuCycles = 2;
 	bool ppuEnabled = false;
-	uint16_t lastOpTicks = 0;
 	uint64_t lastRefresh = 0;
 	uint64_t lastScanline = 0;
 	uint64_t cyclesToStayInHblank = -1;
@@ -35,6 +43,7 @@ class GameBoy {
 	// EI is actually "disable interrupts for one instruction, then enable them"
 	// This keeps track of that
 	bool IME_togge = false;
+	bool setIME = false;
 
 	//Accumulator and flags
 	RegisterPair AF = {0};
@@ -51,37 +60,164 @@ class GameBoy {
 
 	PPUMode currentMode = PPUMode::mode0;
 	Byte windowLineCounter = 0;
-	int16_t cyclesUntilDMATransfer = 160;
 
 	Byte prevTMA = 0;
 	uint64_t lastTIMAUpdate = 0;
+	//T-cycles per TIMA increment, 0 while the timer is stopped. Cached from TAC on write
+	uint16_t TIMAFrequency = 0;
 	bool halted = false;
 	bool haltBug = true;
 	bool stopped = false;
 
-	//3 colour channels
-	uint32_t* framebuffer = new uint32_t[RESOLUTION_X * RESOLUTION_Y * SCREEN_BPP];
-	SDL_Window* screen = nullptr;
-	SDL_Renderer* renderer = nullptr;
-	SDL_Texture* texture = nullptr;
-	SDL_Event event = {0};
-	uint32_t frameStart = 0;
-	uint32_t frameTime = 0;
-	const int frameDelay = 1000 / V_SYNC;
+	//RESOLUTION_Y rows of scanlineBytes(pixelFormat)
+	PixelFormat pixelFormat = pixelARGB8888;
+	std::vector<Byte> framebuffer = std::vector<Byte>(RESOLUTION_Y * RESOLUTION_X * 4);
 
 	Input joypadInput;
 	void joypadHandler();
 
+	Byte read(Word address);
+	void write(Word address, Byte value);
+	//side effects of I/O register writes, indexed by address - 0xFF00 and run after the value is stored
+	using IOWriteHooks = std::array<void (GameBoy::*)(), 0x100>;
+	static const IOWriteHooks ioWriteHooks;
+	void DIVWrite();
+	void TMAWrite();
+	void TACWrite();
+	void LCDCWrite();
+	void STATWrite();
+	void DMAWrite();
+
+	//see idleLoop.cpp
+	struct IdleLoopState {
+		Word PC;
+		Word AF;
+		Word BC;
+		Word DE;
+		Word HL;
+		Word SP;
+		uint8_t IME;
+		uint64_t sideEffects;
+		uint64_t cycles;
+		bool operator==(const IdleLoopState&) const = default;
+	};
+	IdleLoopState idleLoop = {};
+	//bumped by everything an idle loop mustn't do: writing memory, reading DIV/TIMA and servicing events
+	uint64_t loopSideEffects = 0;
+#ifdef GBPP_IDLE_LOOP_VALIDATION
+	IdleLoopState idleLoopPrediction = {};
+	bool idleLoopPredicted = false;
+#endif
+	void idleLoopCheck();
+
+	//the list of fields in a save state, shared by saving and loading. See saveState.cpp
+	template <typename Stream, typename Self>
+	static void transferState(Stream& state, Self& gameboy);
+	mutable std::vector<Byte> stateHashFields;
+
+	void runInstructions(bool singleStep);
+	void serviceEvents();
+	void scheduleTimer();
+	void schedulePPU();
+	void scheduleInterruptCheck();
+
+	using OpcodeTable = std::array<void (*)(GameBoy&), 256>;
+	static const OpcodeTable opcodeTable;
+	static const OpcodeTable extendedOpcodeTable;
 	void opcodeResolver();
+	template <Byte opcode>
+	void executeOpcode();
+	template <Byte opcode>
+	void executeExtendedOpcode();
+	template <Byte opcode>
+	static void dispatchOpcode(GameBoy& gameboy) { gameboy.executeOpcode<opcode>(); }
+	template <Byte opcode>
+	static void dispatchExtendedOpcode(GameBoy& gameboy) { gameboy.executeExtendedOpcode<opcode>(); }
+
+	RenderPolicy renderPolicy = renderAll;
+	uint32_t renderInterval = 1;
+	uint64_t frameCount = 0;
+	bool renderRequested = false;
+	//decided at VBlank for the frame that follows
+	bool renderingFrame = true;
+	bool lastFrameDrawn = true;
+	//whether the next frame to start is drawn, without using up a request
+	bool wouldRenderFrame() const;
+
+	//the render relevant registers of a visible line as they were at the end of its mode 3. Lines are drawn
+	//from these in a batch when the framebuffer is asked for, or before VRAM/OAM change under them
+	struct LineState {
+		Byte LCDC;
+		Byte SCY;
+		Byte SCX;
+		Byte WY;
+		Byte WX;
+		Byte BGP;
+		Byte OBP0;
+		Byte OBP1;
+		Byte windowLine;
+		bool operator==(const LineState&) const = default;
+	};
+	std::array<LineState, RESOLUTION_Y> lineStates = {};
+	std::bitset<RESOLUTION_Y> pendingLines;
+	//hash of what each framebuffer row was last drawn from, see drawLine()
+	std::array<uint64_t, RESOLUTION_Y> lineKeys = {};
+	std::bitset<RESOLUTION_Y> lineKeysValid;
+	//rows whose pixels changed since takeDirtyLines(), all of them to begin with
+	LineMask dirtyLines = LineMask().set();
+	void recordLine();
+	//emulation state, so it runs on skipped frames too
+	void advanceWindowLine();
+	//also called before anything that changes VRAM, OAM or the object index
+	void renderPendingLines();
 
+	TileCache tileCache;
+	ObjectIndex objectIndex;
+	//output pixels for the composer's palette indices, 0-3 BGP (white with BG off), 4-7 OBP0 and 8-11 OBP1.
+	//Rebuilt when a line's palettes differ from the ones it was built from
+	std::array<uint32_t, 16> paletteLUT = {};
+	uint32_t paletteLUTKey = 0;
+	bool paletteLUTBuilt = false;
+	void updatePaletteLUT(const LineState& state);
+#ifdef GBPP_PIXEL_FIFO_PPU
+	//mode 3 of a visible line run dot by dot instead of drawn from the line log, see pixelFifo.cpp
+	struct PixelFifo {
+		uint16_t dot = 0; //dots run since mode 3 started
+		bool active = false;
+		uint8_t startDots = 0; //left of the thrown away first fetch
+		uint8_t x = 0; //pixels shifted out so far
+		uint8_t discard = 0; //SCX fine scroll pixels still to drop
+		//BG/window colour indices, the front is bg[8 - bgCount]
+		std::array<Byte, 8> bg = {};
+		uint8_t bgCount = 0;
+		//object pixels lined up with the next pixels out, encoded like the composer's object layer
+		std::array<Byte, 8> obj = {};
+		uint8_t fetcherDot = 0;
+		uint8_t fetcherX = 0; //tile column of the next fetch
+		bool window = false;
+		bool windowDrawn = false;
+		uint8_t objectFetchDots = 0; //left of an object fetch, nothing is shifted out meanwhile
+		std::array<uint8_t, OBJECTS_PER_LINE> objects = {};
+		uint8_t objectCount = 0;
+		uint8_t nextObject = 0;
+		//the shade each pixel had through the palettes as they were when it was shifted out
+		std::array<Byte, RESOLUTION_X> shades = {};
+	};
+	PixelFifo fifo;
+	void fifoStartLine();
+	//runs the FIFO up to the current dot
+	void fifoCatchUp();
+	void fifoTick();
+	void fifoPushTile();
+	void fifoFetchObject();
+	void fifoFinishLine();
+#endif
 	bool statInteruptLine = false;
 	bool LCDCBitEnabled(Byte bit) const;
 	void incLY();
 	void ppuUpdate();
-	void drawLine();
+	void drawLine(uint8_t line);
 	static bool oamBitEnabled(Byte oamAttributeByte, Byte bit);
-	static unsigned int getColourFromPalette(Byte palette);
-	void SDL2present();
 
 	void checkPPUMode();
 	void setPPUMode(PPUMode mode);
@@ -110,7 +246,7 @@ class GameBoy {
 	Word getWordSP();
 	Byte getByteSP();
 
-	void addCycles(Byte ticks);
+	void addCycles(uint64_t ticks);
 
 	//OPCODE FUNCTIONS
 	template <typename T>
@@ -176,9 +312,57 @@ class GameBoy {
 	void swap(Byte& value);
 
 public:
-	void start(const std::string& bootrom, const std::string& game);
-	void SDL2setup();
-	void SDL2destroy() const;
+	GameBoy() = default;
+	//copying would leave readOnlyAddressSpace on the original, see fork()
+	GameBoy(const GameBoy&) = delete;
+	GameBoy& operator=(const GameBoy&) = delete;
+
+	void loadBootrom(const std::string& path);
+	void loadGame(const std::string& path);
+
+	//runs until the PPU finishes a frame, or for a frame's worth of cycles while the LCD is off
+	void runFrame();
+	//runs for at least this many T-cycles, stopping at the first instruction boundary past them
+	void runCycles(uint64_t ticks);
+	//runs a single instruction, returns true if that finished a frame
+	bool step();
+	void printState() const;
+
+	void setRenderPolicy(RenderPolicy policy, uint32_t interval = 1);
+	//with renderOnRequest, draws the next frame to start
+	void requestRender();
+	//false if the last finished frame was skipped, the framebuffer then still holds the last drawn one
+	bool frameDrawn() const;
+
+	void setInput(const Input& input);
+	//ARGB8888 unless changed. Rows already drawn aren't converted, the framebuffer fills in the new format as
+	//lines are drawn
+	void setPixelFormat(PixelFormat format);
+	PixelFormat getPixelFormat() const;
+	//RESOLUTION_Y rows of scanlineBytes(getPixelFormat()) bytes. Draws any lines still waiting first
+	std::span<const Byte> getFramebuffer();
+	//rows of the framebuffer whose pixels changed since the last call, so uploads and encoders can skip the
+	//rest. Draws any lines still waiting first
+	LineMask takeDirtyLines();
+
+	//Binary save states in a fixed, versioned layout. The ROM has to be loaded already and is only checked by
+	//hash. The size only depends on the cartridge
+	size_t saveStateSize() const;
+	//returns false if the buffer is smaller than saveStateSize()
+	bool saveState(std::span<Byte> buffer) const;
+	//returns false and changes nothing if the buffer isn't a state of this version, build and ROM
+	bool loadState(std::span<const Byte> buffer);
+
+	//A new instance carrying on from this one's state, for exploring several inputs from the same point. The
+	//ROM is shared and RAM is shared copy-on-write per block (VRAM, each work RAM bank, each cartridge RAM
+	//bank), so neither side pays for more than the blocks it writes to afterwards. The child's framebuffer
+	//starts blank apart from lines still waiting to be drawn
+	std::unique_ptr<GameBoy> fork();
+
+	//Hash of everything a save state holds, equal exactly when the states are (short of collisions) whatever
+	//either instance's render policy. RAM is hashed in 256 byte pages and only pages written since the last
+	//call are hashed again, so calling it every frame costs a fraction of a save state. See stateHash.cpp
+	StateHash stateHash() const;
 
 	GameboyTestState runTest(GameboyTestState initial);
 };
@@ -0,0 +1,46 @@
+#include <cstdio>
+#include "gameboy.hpp"
+
+//Games that don't HALT spin in loops like "ldh a,(0x44); cp 0x90; jr nz" waiting for LY or STAT to change.
+//Called on every backward jump. If the jump lands on the same PC as last time with the same registers and
+//nothing written, no DIV/TIMA read and no event serviced in between, the loop can only read memory that
+//won't change until the next event, so every iteration until then is identical and can be skipped
+void GameBoy::idleLoopCheck() {
+	const IdleLoopState state = {PC, AF.reg, BC.reg, DE.reg, HL.reg, SP, IME, loopSideEffects, cycles};
+
+#ifdef GBPP_IDLE_LOOP_VALIDATION
+	//the skipped iterations were run for real, check they ended up where the skip would have put us
+	if (idleLoopPredicted && cycles >= idleLoopPrediction.cycles) {
+		if (state != idleLoopPrediction)
+			fprintf(stderr, "Idle loop skip at PC 0x%.4X to cycle %lu mispredicted, got PC 0x%.4X at cycle %lu\n",
+			        idleLoopPrediction.PC, static_cast<unsigned long>(idleLoopPrediction.cycles), PC,
+			        static_cast<unsigned long>(cycles));
+		idleLoopPredicted = false;
+	}
+#endif
+
+	IdleLoopState previous = idleLoop;
+	idleLoop = state;
+	const uint64_t iterationCycles = cycles - previous.cycles;
+	previous.cycles = cycles;
+	if (previous != state)
+		return;
+
+	//cycles doesn't include this jump yet, so stop an iteration short of the event to be sure the loop head
+	//we land on is still before it
+	const uint64_t nextEvent = scheduler.nextEvent();
+	if (nextEvent == Scheduler::never || nextEvent <= cycles + 2 * iterationCycles)
+		return;
+	const uint64_t skippedCycles = ((nextEvent - 1 - cycles) / iterationCycles - 1) * iterationCycles;
+
+#ifdef GBPP_IDLE_LOOP_VALIDATION
+	if (idleLoopPredicted)
+		return;
+	idleLoopPrediction = state;
+	idleLoopPrediction.cycles += skippedCycles;
+	idleLoopPredicted = true;
+#else
+	addCycles(skippedCycles);
+	idleLoop.cycles = cycles;
+#endif
+}
@@ -15,6 +15,15 @@ void GameBoy::resetInterrupt(const Byte interrupt) {
 	addressSpace.memoryLayout.IF |= 0xE0;
 }
 
+//only worth looking at interrupts while one is pending that can be taken or end a HALT, or EI is taking effect
+void GameBoy::scheduleInterruptCheck() {
+	const Byte pending = readOnlyAddressSpace.memoryLayout.IF & readOnlyAddressSpace.memoryLayout.IE & 0x1F;
+	if (IME_togge || setIME || pending && (IME || halted))
+		scheduler.schedule(interruptEvent, cycles);
+	else
+		scheduler.cancel(interruptEvent);
+}
+
 void GameBoy::interruptHandler() {
 	if (readOnlyAddressSpace.memoryLayout.IF & static_cast<Byte>(1 << VBLANK_INTERRUPT) && testInterruptEnabled(
 		VBLANK_INTERRUPT)) {
@@ -3,6 +3,7 @@
 
 void GameBoy::joypadHandler() {
 	const Byte joyP = addressSpace.memoryLayout.JOYP;
+	const Byte previousLines = joyP & 0x0F;
 	const bool buttons = (joyP & 0x20) == 0;
 	const bool dpad = (joyP & 0x10) == 0;
 
@@ -41,4 +42,10 @@ void GameBoy::joypadHandler() {
 		if (joypadInput.DOWN && joypadInput.START)
 			addressSpace.memoryLayout.JOYP &= ~0x8;
 	}
+
+	//any selected line going low requests the joypad interrupt, which is also what wakes a HALT waiting on input
+	if (previousLines & ~addressSpace.memoryLayout.JOYP & 0x0F) {
+		setInterrupt(JOYPAD_INTERRUPT);
+		scheduleInterruptCheck();
+	}
 }
@@ -0,0 +1,32 @@
+#ifndef GBPP_SRC_LINESPANS_HPP_
+#define GBPP_SRC_LINESPANS_HPP_
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+#include "defines.hpp"
+
+//framebuffer rows, bit n for row n
+using LineMask = std::bitset<RESOLUTION_Y>;
+
+//a run of consecutive rows
+struct LineSpan {
+	uint8_t first;
+	uint8_t count;
+};
+
+//the set rows as runs, top to bottom
+inline std::vector<LineSpan> lineSpans(const LineMask& lines) {
+	std::vector<LineSpan> spans;
+	for (int line = 0; line < RESOLUTION_Y; line++) {
+		if (!lines.test(line))
+			continue;
+		if (!spans.empty() && spans.back().first + spans.back().count == line)
+			spans.back().count++;
+		else
+			spans.push_back({static_cast<uint8_t>(line), 1});
+	}
+	return spans;
+}
+
+#endif //GBPP_SRC_LINESPANS_HPP_
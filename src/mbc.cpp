@@ -1,9 +1,11 @@
+#include <algorithm>
 #include "addressSpace.hpp"
+#include "mbc.hpp"
 
 void AddressSpace::determineMBCInfo() {
 	MBC = static_cast<MBCType>(memoryLayout.romBank0[0x147]);
-	romSize = 32768 * (1 << memoryLayout.romBank0[0x147]);
-	romBanks = 1 << (memoryLayout.romBank0[0x147] + 1);
+	romSize = 32768 * (1 << memoryLayout.romBank0[0x148]);
+	romBanks = 1 << (memoryLayout.romBank0[0x148] + 1);
 
 	const Byte ramSize = memoryLayout.romBank0[0x0149];
 	switch (ramSize) {
@@ -33,103 +35,118 @@ void AddressSpace::determineMBCInfo() {
 		//only the lower 4 bits are usable
 		externalRamSize = 512;
 	}
+
+	mbcController = MBCController::create(MBC, romBanks, externalRamBanks);
+}
+
+std::unique_ptr<MBCController> MBCController::create(const MBCType type, const uint32_t romBanks,
+                                                     const uint32_t ramBanks) {
+	switch (type) {
+	case MBC1:
+	case MBC1Ram:
+	case MBC1RamBattery:
+		return std::make_unique<MBC1Controller>(romBanks, ramBanks);
+	default:
+		return std::make_unique<RomOnlyController>();
+	}
+}
+
+MBCState MBCController::saveState() const {
+	return {romBank0, romBank, ramBank, ramEnabled, {}};
 }
 
-bool AddressSpace::testMBCWrite(const Word address) {
-	if (address <= 0x7FFF)
-		return true;
+void MBCController::loadState(const MBCState& state) {
+	romBank0 = state.romBank0;
+	romBank = state.romBank;
+	ramBank = state.ramBank;
+	ramEnabled = state.ramEnabled;
+}
+
+bool RomOnlyController::write(Word, Byte) {
 	return false;
 }
 
-Byte* AddressSpace::MBCRead(const Word address) {
-	if (MBC == MBC1) {
-		if (address <= 0x1FFF)
-			return &ramEnable;
-		if (address <= 0x3FFF)
-			return &romBankRegister;
-		if (address <= 0x5FFF)
-			return &twoBitBankRegister;
-		if (address <= 0x7FFF)
-			return &romRamSelect;
-	}
-	if (MBC == MBC1Ram || MBC == MBC1RamBattery) {
-		if (address <= 0x1FFF)
-			return &ramEnable;
-		//bits 0-4
-		if (address <= 0x3FFF)
-			return &romBankRegister;
-		if (address <= 0x5FFF) {
-			return &twoBitBankRegister;
-		}
-		if (address <= 0x7FFF)
-			return &romRamSelect;
-	}
-	return &dummyVal;
+MBC1Controller::MBC1Controller(const uint32_t romBanks, const uint32_t ramBanks) :
+	romBankMask(romBanks - 1), ramBankMask(ramBanks ? ramBanks - 1 : 0) {
 }
 
-void AddressSpace::MBCUpdate() {
-	//TODO: multicart roms need to be able to switch the first rom bank as well
-	//see: https://gbdev.io/pandocs/MBC1.html
-	if (MBC == MBC1) {
-		//Selected ROM Bank = (Secondary Bank << 5) + ROM Bank
-		romBankRegister &= 0x1F;
-		twoBitBankRegister &= 0x3;
-
-		//512 KiB can only have 8KiB of ram
-		if (romSize >= 524288) {
-			if (romBankRegister == 0)
-				selectedRomBank = (twoBitBankRegister << 5) + 1;
-			selectedRomBank = (twoBitBankRegister << 5) + romBankRegister;
-		}
-		else {
-			if (romBankRegister == 0)
-				selectedRomBank = 1;
-			else
-				selectedRomBank = romBankRegister;
-		}
-		selectedExternalRamBank = 0;
-
-		loadRomBank();
-		loadRamBank();
-	}
-	if (MBC == MBC1Ram || MBC == MBC1RamBattery) {
-		//Selected ROM Bank = (Secondary Bank << 5) + ROM Bank
-		romBankRegister &= 0x1F;
-		twoBitBankRegister &= 0x3;
-
-		//512 KiB can only have 8KiB of ram
-		if (romSize >= 524288) {
-			if (romBankRegister == 0)
-				selectedRomBank = (twoBitBankRegister << 5) + 1;
-			selectedRomBank = (twoBitBankRegister << 5) + romBankRegister;
-			selectedExternalRamBank = 0;
-		}
-		else {
-			if (romBankRegister == 0)
-				selectedRomBank = 1;
-			else
-				selectedRomBank = romBankRegister;
-			selectedExternalRamBank = twoBitBankRegister;
-		}
-		loadRomBank();
-		loadRamBank();
+bool MBC1Controller::write(const Word address, const Byte value) {
+	const bool previousRamEnabled = ramEnabled;
+	const uint32_t previousRomBank0 = romBank0;
+	const uint32_t previousRomBank = romBank;
+	const uint32_t previousRamBank = ramBank;
+
+	switch (address >> 13) {
+	case 0:
+		ramEnabled = (value & 0x0F) == 0x0A;
+		break;
+	case 1:
+		//bank 0 can't be selected here, 0x20/0x40/0x60 map to 0x21/0x41/0x61
+		bank1 = value & 0x1F;
+		if (bank1 == 0)
+			bank1 = 1;
+		break;
+	case 2:
+		bank2 = value & 0x03;
+		break;
+	default:
+		advancedBanking = value & 0x01;
+		break;
 	}
+
+	//Selected ROM Bank = (Secondary Bank << 5) + ROM Bank
+	romBank = ((bank2 << 5) | bank1) & romBankMask;
+	//in advanced mode the secondary register also switches 0x0000 (large ROMs) or 0xA000 (32 KiB RAM)
+	romBank0 = advancedBanking ? (bank2 << 5) & romBankMask : 0;
+	ramBank = advancedBanking ? bank2 & ramBankMask : 0;
+	return ramEnabled != previousRamEnabled || romBank0 != previousRomBank0 || romBank != previousRomBank ||
+		ramBank != previousRamBank;
+}
+
+MBCState MBC1Controller::saveState() const {
+	MBCState state = MBCController::saveState();
+	state.registers[0] = bank1;
+	state.registers[1] = bank2;
+	state.registers[2] = advancedBanking;
+	return state;
+}
+
+void MBC1Controller::loadState(const MBCState& state) {
+	MBCController::loadState(state);
+	bank1 = state.registers[0];
+	bank2 = state.registers[1];
+	advancedBanking = state.registers[2];
 }
 
 void AddressSpace::loadRomBank() {
-	memoryLayout.romBankSwitch = game.data() + (ROM_BANK_SIZE * selectedRomBank);
+	memoryLayout.romBank0 = game->data() + (ROM_BANK_SIZE * mbcController->romBank0);
+	memoryLayout.romBankSwitch = game->data() + (ROM_BANK_SIZE * mbcController->romBank);
+	mapReadPages(0x0000, ROM_BANK_SIZE, memoryLayout.romBank0);
+	if (bootromLoaded)
+		mapReadPages(0x0000, BOOTROM_SIZE, bootrom);
+	mapReadPages(0x4000, ROM_BANK_SIZE, memoryLayout.romBankSwitch);
 }
 
 void AddressSpace::createRamBank() {
+	cartridgeRamBanks.clear();
+	cartridgeRamGenerations.clear();
 	if (externalRamSize) {
-		cartridgeRam = new Byte[externalRamSize];
-		memoryLayout.externalRam = cartridgeRam;
+		//a bank at most, MBC2 only has 512 bytes
+		cartridgeRamBankSize = std::min<uint32_t>(externalRamSize, RAM_BANK_SIZE);
+		cartridgeRamBanks.resize(std::max<uint32_t>(externalRamBanks, 1));
+		for (auto& bank : cartridgeRamBanks)
+			bank = std::make_shared<Byte[]>(cartridgeRamBankSize);
+		cartridgeRamGenerations.resize(cartridgeRamBanks.size() * (cartridgeRamBankSize >> 8));
 	}
+	//remaps 0xA000 even without RAM, nothing may point into the banks just dropped
+	loadRamBank();
 }
 
+//disabled cartridge RAM is left unmapped so reads return 0xFF and writes are dropped
 void AddressSpace::loadRamBank() {
-	if (cartridgeRam != nullptr)
-		memoryLayout.externalRam = cartridgeRam + (RAM_BANK_SIZE * selectedExternalRamBank);
+	if (!cartridgeRamBanks.empty() && mbcController->ramEnabled)
+		memoryLayout.externalRam = cartridgeRamBanks[mbcController->ramBank].get();
+	else
+		memoryLayout.externalRam = nullptr;
+	mapExternalRam();
 }
-
-
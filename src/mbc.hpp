@@ -0,0 +1,64 @@
+#ifndef MBC_HPP
+#define MBC_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include "defines.hpp"
+
+//the bank registers of any controller in one fixed layout, for save states
+struct MBCState {
+	uint32_t romBank0;
+	uint32_t romBank;
+	uint32_t ramBank;
+	bool ramEnabled;
+	Byte registers[3]; //controller specific
+};
+
+//Bank selection logic for one mapper type. AddressSpace forwards writes to 0x0000-0x7FFF here and only
+//remaps its ROM and RAM pages when write() reports that the selected banks changed
+class MBCController {
+public:
+	virtual ~MBCController() = default;
+	//returns true if any of the banks below or ramEnabled changed
+	virtual bool write(Word address, Byte value) = 0;
+
+	uint32_t romBank0 = 0; //Mapped to 0x0000
+	uint32_t romBank = 1; //Mapped to 0x4000
+	uint32_t ramBank = 0; //Mapped to 0xA000
+	bool ramEnabled = false;
+
+	virtual MBCState saveState() const;
+	virtual void loadState(const MBCState& state);
+
+	static std::unique_ptr<MBCController> create(MBCType type, uint32_t romBanks, uint32_t ramBanks);
+};
+
+//No banking, also used for mappers that aren't supported yet so their fixed banks still work
+class RomOnlyController final : public MBCController {
+public:
+	RomOnlyController() {
+		ramEnabled = true;
+	}
+
+	bool write(Word address, Byte value) override;
+};
+
+//see: https://gbdev.io/pandocs/MBC1.html
+class MBC1Controller final : public MBCController {
+	uint32_t romBankMask;
+	uint32_t ramBankMask;
+	//5 bit ROM bank register
+	Byte bank1 = 1;
+	//2 bit register acts as secondary rom bank register or ram bank number
+	Byte bank2 = 0;
+	bool advancedBanking = false;
+
+public:
+	MBC1Controller(uint32_t romBanks, uint32_t ramBanks);
+	bool write(Word address, Byte value) override;
+	MBCState saveState() const override;
+	void loadState(const MBCState& state) override;
+};
+
+#endif //MBC_HPP
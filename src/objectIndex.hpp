@@ -0,0 +1,108 @@
+#ifndef GBPP_SRC_OBJECTINDEX_HPP_
+#define GBPP_SRC_OBJECTINDEX_HPP_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include "defines.hpp"
+
+#define OAM_OBJECT_COUNT 40
+#define OBJECTS_PER_LINE 10
+
+//Which OAM objects cover each visible line, kept up to date on OAM writes and DMA so drawLine() doesn't scan
+//and sort all 40 entries for every line. Objects are also kept ranked by X (then OAM index), the order they
+//take priority in
+class ObjectIndex {
+	//bit n is set when object n covers the line
+	std::array<uint64_t, RESOLUTION_Y> lines = {};
+	//OAM Y and X as last indexed
+	std::array<Byte, OAM_OBJECT_COUNT> objectY = {};
+	std::array<Byte, OAM_OBJECT_COUNT> objectX = {};
+	std::array<uint8_t, OAM_OBJECT_COUNT> rank = {};
+	std::array<uint8_t, OAM_OBJECT_COUNT> byRank = {};
+	int height = 8;
+
+	void mark(const uint8_t object, const bool covers) {
+		const int top = objectY[object] - 16;
+		for (int line = std::max(top, 0); line < std::min(top + height, RESOLUTION_Y); line++) {
+			if (covers)
+				lines[line] |= 1ULL << object;
+			else
+				lines[line] &= ~(1ULL << object);
+		}
+	}
+
+	//insertion sort, a single X change only moves one object
+	void sortByX() {
+		for (int i = 1; i < OAM_OBJECT_COUNT; i++) {
+			const uint8_t object = byRank[i];
+			int j = i;
+			for (; j > 0 && (objectX[byRank[j - 1]] > objectX[object] ||
+				       (objectX[byRank[j - 1]] == objectX[object] && byRank[j - 1] > object)); j--)
+				byRank[j] = byRank[j - 1];
+			byRank[j] = object;
+		}
+		for (int i = 0; i < OAM_OBJECT_COUNT; i++)
+			rank[byRank[i]] = i;
+	}
+
+public:
+	//matches an all zero OAM, every object above the screen
+	ObjectIndex() {
+		for (int i = 0; i < OAM_OBJECT_COUNT; i++)
+			rank[i] = byRank[i] = i;
+	}
+
+	//offset is 0xFE00 based
+	void write(const Byte* oam, const Word offset) {
+		const uint8_t object = offset / 4;
+		if (offset % 4 == 0) {
+			mark(object, false);
+			objectY[object] = oam[offset];
+			mark(object, true);
+		}
+		else if (offset % 4 == 1) {
+			objectX[object] = oam[offset];
+			sortByX();
+		}
+	}
+
+	void rebuild(const Byte* oam) {
+		lines.fill(0);
+		for (int object = 0; object < OAM_OBJECT_COUNT; object++) {
+			objectY[object] = oam[object * 4];
+			objectX[object] = oam[object * 4 + 1];
+			mark(object, true);
+		}
+		sortByX();
+	}
+
+	int objectHeight() const {
+		return height;
+	}
+
+	//8 or 16 from LCDC
+	void setHeight(const Byte* oam, const int objectHeight) {
+		if (objectHeight == height)
+			return;
+		height = objectHeight;
+		rebuild(oam);
+	}
+
+	//the first 10 objects in OAM order covering the line, highest priority first. Returns how many
+	int objectsOnLine(const uint8_t line, std::array<uint8_t, OBJECTS_PER_LINE>& objects) const {
+		uint64_t candidates = lines[line];
+		uint64_t ranked = 0;
+		for (int found = 0; candidates && found < OBJECTS_PER_LINE; found++) {
+			ranked |= 1ULL << rank[std::countr_zero(candidates)];
+			candidates &= candidates - 1;
+		}
+		int count = 0;
+		for (; ranked; ranked &= ranked - 1)
+			objects[count++] = byRank[std::countr_zero(ranked)];
+		return count;
+	}
+};
+
+#endif //GBPP_SRC_OBJECTINDEX_HPP_
@@ -47,24 +47,12 @@ void GameBoy::ret() {
 
 template <typename T>
 void GameBoy::ld(T& dest, T src) {
-	if constexpr (std::is_same_v<T, Byte>) {
-		if (&dest == &addressSpace.memoryLayout.DIV) {
-			addressSpace.memoryLayout.DIV = 0x00;
-			lastDivUpdate = cycles;
-		}
-		else {
-			dest = src;
-		}
-	}
-	else {
-		//16-bit register pair write
-		dest = src;
-	}
+	dest = src;
 }
 
 void GameBoy::ldW(const Word destAddr, const Word src) {
-	addressSpace[destAddr] = static_cast<Byte>(src & 0xFF);
-	addressSpace[destAddr + 1] = static_cast<Byte>((src & 0xFF00) >> 8);
+	write(destAddr, static_cast<Byte>(src & 0xFF));
+	write(destAddr + 1, static_cast<Byte>((src & 0xFF00) >> 8));
 }
 
 template <typename T>
@@ -260,6 +248,8 @@ void GameBoy::res(const Byte testBit, Byte& reg) {
 template <typename T>
 void GameBoy::jr(T offset) {
 	PC += static_cast<int8_t>(offset) + 2; //PC moves 2 from original instruction
+	if (static_cast<int8_t>(offset) < 0)
+		idleLoopCheck();
 }
 
 template <typename T>
@@ -269,6 +259,8 @@ bool GameBoy::jrNZ(T offset) {
 	{
 		PC += static_cast<int8_t>(offset) + 2; //PC moves 2 from the original instruction
 		jumped = true;
+		if (static_cast<int8_t>(offset) < 0)
+			idleLoopCheck();
 	}
 
 	return jumped;
@@ -281,6 +273,8 @@ bool GameBoy::jrZ(T offset) {
 	{
 		PC += static_cast<int8_t>(offset) + 2; //PC moves 2 from the original instruction
 		jumped = true;
+		if (static_cast<int8_t>(offset) < 0)
+			idleLoopCheck();
 	}
 
 	return jumped;
@@ -293,6 +287,8 @@ bool GameBoy::jrNC(T offset) {
 	{
 		PC += static_cast<int8_t>(offset) + 2; //PC moves 2 from the original instruction
 		jumped = true;
+		if (static_cast<int8_t>(offset) < 0)
+			idleLoopCheck();
 	}
 
 	return jumped;
@@ -305,6 +301,8 @@ bool GameBoy::jrC(T offset) {
 	{
 		PC += static_cast<int8_t>(offset) + 2; //PC moves 2 from the original instruction
 		jumped = true;
+		if (static_cast<int8_t>(offset) < 0)
+			idleLoopCheck();
 	}
 
 	return jumped;
@@ -395,6 +393,7 @@ void GameBoy::halt() {
 	halted = true;
 	if (!IME && addressSpace.memoryLayout.IE & addressSpace.memoryLayout.IF)
 		haltBug = true;
+	scheduleInterruptCheck();
 }
 
 void GameBoy::rrc(Byte& reg) {
@@ -618,13 +617,16 @@ void GameBoy::pop(T& reg) {
 
 void GameBoy::push(const Word reg) {
 	//little endian
-	addressSpace[--SP] = reg >> 8;
-	addressSpace[--SP] = reg & 0xFF;
+	write(--SP, reg >> 8);
+	write(--SP, reg & 0xFF);
 }
 
 template <typename T>
 void GameBoy::jp(T address) {
+	const bool backwards = address <= PC;
 	PC = address;
+	if (backwards)
+		idleLoopCheck();
 }
 
 template <typename T>
@@ -660,1590 +662,1871 @@ void GameBoy::stop() {
 	stopped = true;
 }
 
-void GameBoy::opcodeResolver() {
-	if (readOnlyAddressSpace[PC] != 0xCB) {
-		bool jumped;
-		switch (readOnlyAddressSpace[PC]) {
-		case 0x00:
-			//NOP
-			PC += 1;
-			addCycles(4);
-			break;
-
-		case 0x01:
-			ld(BC.reg, getWordPC());
-			PC += 3;
-			addCycles(12);
-			break;
-
-		case 0x02:
-			ld(addressSpace[BC.reg], AF.hi);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x03:
-			BC.reg += 1;
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x04:
-			inc(BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+//opcodes without a specialisation below are the unused ones
+template <Byte opcode>
+void GameBoy::executeOpcode() {
+	printf("Unsupported opcode found: PC:0x%.2x, Opcode:0x%.2x\n", PC, opcode);
+	exit(1);
+}
 
-		case 0x05:
-			dec(BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x00>() {
+	//NOP
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x06:
-			ld(BC.hi, getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x01>() {
+	ld(BC.reg, getWordPC());
+	PC += 3;
+	addCycles(12);
+}
 
-		case 0x07:
-			rlca();
-			PC += 1;
-			addCycles(4);
-			break;
-
-		case 0x08:
-			ldW(getWordPC(), SP);
-			PC += 3;
-			addCycles(20);
-			break;
-
-		case 0x09:
-			add(HL.reg, BC.reg);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x0A:
-			ld(AF.hi, readOnlyAddressSpace[BC.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x0B:
-			BC.reg -= 1;
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x0C:
-			inc(BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x02>() {
+	write(BC.reg, AF.hi);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x0D:
-			dec(BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x03>() {
+	BC.reg += 1;
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x0E:
-			ld(BC.lo, getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x04>() {
+	inc(BC.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x0F:
-			rrca();
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x05>() {
+	dec(BC.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x10:
-			stop();
-			PC += 2;
-			addCycles(4);
-			break;
-
-		case 0x11:
-			ld(DE.reg, getWordPC());
-			PC += 3;
-			addCycles(12);
-			break;
-
-		case 0x12:
-			ld(addressSpace[DE.reg], AF.hi);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x13:
-			DE.reg += 1; //no flags change no just inc it manually
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x14:
-			inc(DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x06>() {
+	ld(BC.hi, getBytePC());
+	PC += 2;
+	addCycles(8);
+}
 
-		case 0x15:
-			dec(DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x07>() {
+	rlca();
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x16:
-			ld(DE.hi, getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x08>() {
+	ldW(getWordPC(), SP);
+	PC += 3;
+	addCycles(20);
+}
 
-		case 0x17:
-			rla();
-			PC += 1;
-			addCycles(4);
-			break;
-
-		case 0x18:
-			jr(getBytePC());
-			addCycles(12);
-			break;
-
-		case 0x19:
-			add(HL.reg, DE.reg);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x1A:
-			ld(AF.hi, readOnlyAddressSpace[DE.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x1B:
-			DE.reg -= 1;
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x1C:
-			inc(DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x09>() {
+	add(HL.reg, BC.reg);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x1D:
-			dec(DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x0A>() {
+	ld(AF.hi, read(BC.reg));
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x1E:
-			ld(DE.lo, getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x0B>() {
+	BC.reg -= 1;
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x1F:
-			rra();
-			PC += 1;
-			addCycles(4);
-			break;
-
-		case 0x20:
-			jumped = jrNZ(getBytePC());
-			if (jumped) {
-				addCycles(12);
-			}
-			else {
-				PC += 2;
-				addCycles(8);
-			}
-			break;
-
-		case 0x21:
-			ld(HL.reg, getWordPC());
-			PC += 3;
-			addCycles(12);
-			break;
-
-		case 0x22:
-			ld(addressSpace[HL.reg], AF.hi);
-			HL.reg += 1;
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x23:
-			inc(HL.reg);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x24:
-			inc(HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x0C>() {
+	inc(BC.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x25:
-			dec(HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x0D>() {
+	dec(BC.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x26:
-			ld(HL.hi, getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x0E>() {
+	ld(BC.lo, getBytePC());
+	PC += 2;
+	addCycles(8);
+}
 
-		case 0x27:
-			daa();
-			PC += 1;
-			addCycles(4);
-			break;
-
-		case 0x28:
-			jumped = jrZ(getBytePC());
-			if (jumped) {
-				addCycles(12);
-			}
-			else {
-				PC += 2;
-				addCycles(8);
-			}
-			break;
-
-		case 0x29:
-			add(HL.reg, HL.reg);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x2A:
-			ld(AF.hi, readOnlyAddressSpace[HL.reg]);
-			HL.reg += 1;
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x2B:
-			dec(HL.reg);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x2C:
-			inc(HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x0F>() {
+	rrca();
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x2D:
-			dec(HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x10>() {
+	stop();
+	PC += 2;
+	addCycles(4);
+}
 
-		case 0x2E:
-			ld(HL.lo, getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x11>() {
+	ld(DE.reg, getWordPC());
+	PC += 3;
+	addCycles(12);
+}
 
-		case 0x2F:
-			cpl();
-			PC += 1;
-			addCycles(4);
-			break;
-
-		case 0x30:
-			jumped = jrNC(getBytePC());
-			if (jumped) {
-				addCycles(12);
-			}
-			else {
-				PC += 2;
-				addCycles(8);
-			}
-			break;
-
-		case 0x31:
-			ld(SP, getWordPC());
-			PC += 3;
-			addCycles(12);
-			break;
-
-		case 0x32:
-			ld(addressSpace[HL.reg], AF.hi);
-			HL.reg -= 1;
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x33:
-			SP += 1;
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x34:
-			inc(addressSpace[HL.reg]);
-			PC += 1;
-			addCycles(12);
-			break;
-
-		case 0x35:
-			dec(addressSpace[HL.reg]);
-			PC += 1;
-			addCycles(12);
-			break;
-
-		case 0x36:
-			ld(addressSpace[HL.reg], getBytePC());
-			PC += 2;
-			addCycles(12);
-			break;
-
-		case 0x37:
-			scf();
-			PC += 1;
-			addCycles(4);
-			break;
-
-		case 0x38:
-			jumped = jrC(getBytePC());
-			if (jumped) {
-				addCycles(12);
-			}
-			else {
-				PC += 2;
-				addCycles(8);
-			}
-			break;
-
-		case 0x39:
-			add(HL.reg, SP);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x3A:
-			ld(AF.hi, readOnlyAddressSpace[HL.reg]);
-			HL.reg -= 1;
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x3B:
-			SP -= 1;
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x3C:
-			inc(AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x12>() {
+	write(DE.reg, AF.hi);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x3D:
-			dec(AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x13>() {
+	DE.reg += 1; //no flags change no just inc it manually
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x3E:
-			ld(AF.hi, getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x14>() {
+	inc(DE.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x3F:
-			ccf();
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x15>() {
+	dec(DE.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x40:
-			ld(BC.hi, BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x16>() {
+	ld(DE.hi, getBytePC());
+	PC += 2;
+	addCycles(8);
+}
 
-		case 0x41:
-			ld(BC.hi, BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x17>() {
+	rla();
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x42:
-			ld(BC.hi, DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x18>() {
+	jr(getBytePC());
+	addCycles(12);
+}
 
-		case 0x43:
-			ld(BC.hi, DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x19>() {
+	add(HL.reg, DE.reg);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x44:
-			ld(BC.hi, HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x1A>() {
+	ld(AF.hi, read(DE.reg));
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x45:
-			ld(BC.hi, HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x1B>() {
+	DE.reg -= 1;
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x46:
-			ld(BC.hi, readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x1C>() {
+	inc(DE.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x47:
-			ld(BC.hi, AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x1D>() {
+	dec(DE.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x48:
-			ld(BC.lo, BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x1E>() {
+	ld(DE.lo, getBytePC());
+	PC += 2;
+	addCycles(8);
+}
 
-		case 0x49:
-			ld(BC.lo, BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x1F>() {
+	rra();
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x4A:
-			ld(BC.lo, DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x20>() {
+	if (jrNZ(getBytePC())) {
+		addCycles(12);
+	}
+	else {
+		PC += 2;
+		addCycles(8);
+	}
+}
 
-		case 0x4B:
-			ld(BC.lo, DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x21>() {
+	ld(HL.reg, getWordPC());
+	PC += 3;
+	addCycles(12);
+}
 
-		case 0x4C:
-			ld(BC.lo, HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x22>() {
+	write(HL.reg, AF.hi);
+	HL.reg += 1;
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x4D:
-			ld(BC.lo, HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x23>() {
+	inc(HL.reg);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x4E:
-			ld(BC.lo, readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x24>() {
+	inc(HL.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x4F:
-			ld(BC.lo, AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x25>() {
+	dec(HL.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x50:
-			ld(DE.hi, BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x26>() {
+	ld(HL.hi, getBytePC());
+	PC += 2;
+	addCycles(8);
+}
 
-		case 0x51:
-			ld(DE.hi, BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x27>() {
+	daa();
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x52:
-			ld(DE.hi, DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x28>() {
+	if (jrZ(getBytePC())) {
+		addCycles(12);
+	}
+	else {
+		PC += 2;
+		addCycles(8);
+	}
+}
 
-		case 0x53:
-			ld(DE.hi, DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x29>() {
+	add(HL.reg, HL.reg);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x54:
-			ld(DE.hi, HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x2A>() {
+	ld(AF.hi, read(HL.reg));
+	HL.reg += 1;
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x55:
-			ld(DE.hi, HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x2B>() {
+	dec(HL.reg);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x56:
-			ld(DE.hi, readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x2C>() {
+	inc(HL.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x57:
-			ld(DE.hi, AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x2D>() {
+	dec(HL.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x58:
-			ld(DE.lo, BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x2E>() {
+	ld(HL.lo, getBytePC());
+	PC += 2;
+	addCycles(8);
+}
 
-		case 0x59:
-			ld(DE.lo, BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x2F>() {
+	cpl();
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x5A:
-			ld(DE.lo, DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x30>() {
+	if (jrNC(getBytePC())) {
+		addCycles(12);
+	}
+	else {
+		PC += 2;
+		addCycles(8);
+	}
+}
 
-		case 0x5B:
-			ld(DE.lo, DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x31>() {
+	ld(SP, getWordPC());
+	PC += 3;
+	addCycles(12);
+}
 
-		case 0x5C:
-			ld(DE.lo, HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x32>() {
+	write(HL.reg, AF.hi);
+	HL.reg -= 1;
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x5D:
-			ld(DE.lo, HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x33>() {
+	SP += 1;
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x5E:
-			ld(DE.lo, readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x34>() {
+	Byte value = read(HL.reg);
+	inc(value);
+	write(HL.reg, value);
+	PC += 1;
+	addCycles(12);
+}
 
-		case 0x5F:
-			ld(DE.lo, AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x35>() {
+	Byte value = read(HL.reg);
+	dec(value);
+	write(HL.reg, value);
+	PC += 1;
+	addCycles(12);
+}
 
-		case 0x60:
-			ld(HL.hi, BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x36>() {
+	write(HL.reg, getBytePC());
+	PC += 2;
+	addCycles(12);
+}
 
-		case 0x61:
-			ld(HL.hi, BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x37>() {
+	scf();
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x62:
-			ld(HL.hi, DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x38>() {
+	if (jrC(getBytePC())) {
+		addCycles(12);
+	}
+	else {
+		PC += 2;
+		addCycles(8);
+	}
+}
 
-		case 0x63:
-			ld(HL.hi, DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x39>() {
+	add(HL.reg, SP);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x64:
-			ld(HL.hi, HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x3A>() {
+	ld(AF.hi, read(HL.reg));
+	HL.reg -= 1;
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x65:
-			ld(HL.hi, HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x3B>() {
+	SP -= 1;
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x66:
-			ld(HL.hi, readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x3C>() {
+	inc(AF.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x67:
-			ld(HL.hi, AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x3D>() {
+	dec(AF.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x68:
-			ld(HL.lo, BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x3E>() {
+	ld(AF.hi, getBytePC());
+	PC += 2;
+	addCycles(8);
+}
 
-		case 0x69:
-			ld(HL.lo, BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x3F>() {
+	ccf();
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x6A:
-			ld(HL.lo, DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x40>() {
+	ld(BC.hi, BC.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x6B:
-			ld(HL.lo, DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x41>() {
+	ld(BC.hi, BC.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x6C:
-			ld(HL.lo, HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x42>() {
+	ld(BC.hi, DE.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x6D:
-			ld(HL.lo, HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x43>() {
+	ld(BC.hi, DE.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x6E:
-			ld(HL.lo, readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x44>() {
+	ld(BC.hi, HL.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x6F:
-			ld(HL.lo, AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
-
-		case 0x70:
-			ld(addressSpace[HL.reg], BC.hi);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x71:
-			ld(addressSpace[HL.reg], BC.lo);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x72:
-			ld(addressSpace[HL.reg], DE.hi);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x73:
-			ld(addressSpace[HL.reg], DE.lo);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x74:
-			ld(addressSpace[HL.reg], HL.hi);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x75:
-			ld(addressSpace[HL.reg], HL.lo);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0x76:
-			halt();
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x45>() {
+	ld(BC.hi, HL.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x77:
-			ld(addressSpace[HL.reg], AF.hi);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x46>() {
+	ld(BC.hi, read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x78:
-			ld(AF.hi, BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x47>() {
+	ld(BC.hi, AF.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x79:
-			ld(AF.hi, BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x48>() {
+	ld(BC.lo, BC.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x7A:
-			ld(AF.hi, DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x49>() {
+	ld(BC.lo, BC.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x7B:
-			ld(AF.hi, DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x4A>() {
+	ld(BC.lo, DE.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x7C:
-			ld(AF.hi, HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x4B>() {
+	ld(BC.lo, DE.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x7D:
-			ld(AF.hi, HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x4C>() {
+	ld(BC.lo, HL.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x7E:
-			ld(AF.hi, readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x4D>() {
+	ld(BC.lo, HL.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x7F:
-			ld(AF.hi, AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x4E>() {
+	ld(BC.lo, read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x80:
-			add(AF.hi, BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x4F>() {
+	ld(BC.lo, AF.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x81:
-			add(AF.hi, BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x50>() {
+	ld(DE.hi, BC.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x82:
-			add(AF.hi, DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x51>() {
+	ld(DE.hi, BC.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x83:
-			add(AF.hi, DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x52>() {
+	ld(DE.hi, DE.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x84:
-			add(AF.hi, HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x53>() {
+	ld(DE.hi, DE.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x85:
-			add(AF.hi, HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x54>() {
+	ld(DE.hi, HL.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x86:
-			add(AF.hi, readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x55>() {
+	ld(DE.hi, HL.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x87:
-			add(AF.hi, AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x56>() {
+	ld(DE.hi, read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x88:
-			adc(BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x57>() {
+	ld(DE.hi, AF.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x89:
-			adc(BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x58>() {
+	ld(DE.lo, BC.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x8A:
-			adc(DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x59>() {
+	ld(DE.lo, BC.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x8B:
-			adc(DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x5A>() {
+	ld(DE.lo, DE.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x8C:
-			adc(HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x5B>() {
+	ld(DE.lo, DE.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x8D:
-			adc(HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x5C>() {
+	ld(DE.lo, HL.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x8E:
-			adc(readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x5D>() {
+	ld(DE.lo, HL.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x8F:
-			adc(AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x5E>() {
+	ld(DE.lo, read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x90:
-			sub(BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x5F>() {
+	ld(DE.lo, AF.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x91:
-			sub(BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x60>() {
+	ld(HL.hi, BC.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x92:
-			sub(DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x61>() {
+	ld(HL.hi, BC.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x93:
-			sub(DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x62>() {
+	ld(HL.hi, DE.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x94:
-			sub(HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x63>() {
+	ld(HL.hi, DE.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x95:
-			sub(HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x64>() {
+	ld(HL.hi, HL.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x96:
-			sub(readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x65>() {
+	ld(HL.hi, HL.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x97:
-			sub(AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x66>() {
+	ld(HL.hi, read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0x98:
-			sbc(BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x67>() {
+	ld(HL.hi, AF.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x99:
-			sbc(BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x68>() {
+	ld(HL.lo, BC.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x9A:
-			sbc(DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x69>() {
+	ld(HL.lo, BC.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x9B:
-			sbc(DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x6A>() {
+	ld(HL.lo, DE.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x9C:
-			sbc(HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x6B>() {
+	ld(HL.lo, DE.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x9D:
-			sbc(HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x6C>() {
+	ld(HL.lo, HL.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x9E:
-			sbc(readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x6D>() {
+	ld(HL.lo, HL.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0x9F:
-			sbc(AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x6E>() {
+	ld(HL.lo, read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0xA0:
-			andBitwise(AF.hi, BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x6F>() {
+	ld(HL.lo, AF.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xA1:
-			andBitwise(AF.hi, BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x70>() {
+	write(HL.reg, BC.hi);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0xA2:
-			andBitwise(AF.hi, DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x71>() {
+	write(HL.reg, BC.lo);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0xA3:
-			andBitwise(AF.hi, DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x72>() {
+	write(HL.reg, DE.hi);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0xA4:
-			andBitwise(AF.hi, HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x73>() {
+	write(HL.reg, DE.lo);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0xA5:
-			andBitwise(AF.hi, HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x74>() {
+	write(HL.reg, HL.hi);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0xA6:
-			andBitwise(AF.hi, readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x75>() {
+	write(HL.reg, HL.lo);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0xA7:
-			andBitwise(AF.hi, AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x76>() {
+	halt();
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xA8:
-			xorBitwise(AF.hi, BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x77>() {
+	write(HL.reg, AF.hi);
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0xA9:
-			xorBitwise(AF.hi, BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x78>() {
+	ld(AF.hi, BC.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xAA:
-			xorBitwise(AF.hi, DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x79>() {
+	ld(AF.hi, BC.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xAB:
-			xorBitwise(AF.hi, DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x7A>() {
+	ld(AF.hi, DE.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xAC:
-			xorBitwise(AF.hi, HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x7B>() {
+	ld(AF.hi, DE.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xAD:
-			xorBitwise(AF.hi, HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x7C>() {
+	ld(AF.hi, HL.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xAE:
-			xorBitwise(AF.hi, readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x7D>() {
+	ld(AF.hi, HL.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xAF:
-			xorBitwise(AF.hi, AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x7E>() {
+	ld(AF.hi, read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0xB0:
-			orBitwise(AF.hi, BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x7F>() {
+	ld(AF.hi, AF.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xB1:
-			orBitwise(AF.hi, BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x80>() {
+	add(AF.hi, BC.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xB2:
-			orBitwise(AF.hi, DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x81>() {
+	add(AF.hi, BC.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xB3:
-			orBitwise(AF.hi, DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x82>() {
+	add(AF.hi, DE.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xB4:
-			orBitwise(AF.hi, HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x83>() {
+	add(AF.hi, DE.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xB5:
-			orBitwise(AF.hi, HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x84>() {
+	add(AF.hi, HL.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xB6:
-			orBitwise(AF.hi, readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x85>() {
+	add(AF.hi, HL.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xB7:
-			orBitwise(AF.hi, AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x86>() {
+	add(AF.hi, read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0xB8:
-			cp(BC.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x87>() {
+	add(AF.hi, AF.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xB9:
-			cp(BC.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x88>() {
+	adc(BC.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xBA:
-			cp(DE.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x89>() {
+	adc(BC.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xBB:
-			cp(DE.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x8A>() {
+	adc(DE.hi);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xBC:
-			cp(HL.hi);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x8B>() {
+	adc(DE.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xBD:
-			cp(HL.lo);
-			PC += 1;
-			addCycles(4);
-			break;
+template <>
+void GameBoy::executeOpcode<0x8C>() {
+	adc(HL.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x8D>() {
+	adc(HL.lo);
+	PC += 1;
+	addCycles(4);
+}
 
-		case 0xBE:
-			cp(readOnlyAddressSpace[HL.reg]);
-			PC += 1;
-			addCycles(8);
-			break;
+template <>
+void GameBoy::executeOpcode<0x8E>() {
+	adc(read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
 
-		case 0xBF:
-			cp(AF.hi);
-			PC += 1;
-			addCycles(4);
-			break;
-
-		case 0xC0: //RET NZ
-			if (!getFlag(ZERO_FLAG)) {
-				ret();
-				addCycles(20);
-			}
-			else {
-				addCycles(8);
-				PC += 1;
-			}
-			break;
-
-		case 0xC1:
-			pop(BC.reg);
-			PC += 1;
-			addCycles(12);
-			break;
-
-		case 0xC2:
-			if (!getFlag(ZERO_FLAG)) {
-				jp(getWordPC());
-				addCycles(16);
-			}
-			else {
-				addCycles(12);
-				PC += 3;
-			}
-			break;
-
-		case 0xC3:
-			jp(getWordPC());
-			addCycles(16);
-			break;
-
-		case 0xC4:
-			if (!getFlag(ZERO_FLAG)) {
-				call(getWordPC());
-				addCycles(24);
-			}
-			else {
-				addCycles(12);
-				PC += 3;
-			}
-			break;
-
-		case 0xC5:
-			push(BC.reg);
-			PC += 1;
-			addCycles(16);
-			break;
-
-		case 0xC6:
-			add(AF.hi, getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
-
-		case 0xC7:
-			rst(0x0000);
-			addCycles(16);
-			break;
-
-		case 0xC8:
-			if (getFlag(ZERO_FLAG)) {
-				ret();
-				addCycles(20);
-			}
-			else {
-				addCycles(8);
-				PC += 1;
-			}
-			break;
-
-		case 0xC9:
-			ret();
-			addCycles(16);
-			break;
-
-		case 0xCA:
-			if (getFlag(ZERO_FLAG)) {
-				jp(getWordPC());
-				addCycles(16);
-			}
-			else {
-				addCycles(12);
-				PC += 3;
-			}
-			break;
-
-		case 0xCC:
-			if (getFlag(ZERO_FLAG)) {
-				call(getWordPC());
-				addCycles(24);
-			}
-			else {
-				addCycles(12);
-				PC += 3;
-			}
-			break;
-
-		case 0xCD:
-			call(getWordPC());
-			addCycles(24);
-			break;
-
-		case 0xCE:
-			adc(getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
-
-		case 0xCF:
-			rst(0x08);
-			addCycles(16);
-			break;
-
-		case 0xD0: //RET NC
-			if (!getFlag(CARRY_FLAG)) {
-				ret();
-				addCycles(20);
-			}
-			else {
-				addCycles(8);
-				PC += 1;
-			}
-			break;
-
-		case 0xD1:
-			pop(DE.reg);
-			PC += 1;
-			addCycles(12);
-			break;
-
-		case 0xD2:
-			if (!getFlag(CARRY_FLAG)) {
-				jp(getWordPC());
-				addCycles(24);
-			}
-			else {
-				addCycles(12);
-				PC += 3;
-			}
-			break;
-
-		case 0xD4:
-			if (!getFlag(CARRY_FLAG)) {
-				call(getWordPC());
-				addCycles(24);
-			}
-			else {
-				addCycles(12);
-				PC += 3;
-			}
-			break;
-
-		case 0xD5:
-			push(DE.reg);
-			PC += 1;
-			addCycles(16);
-			break;
-
-		case 0xD6:
-			sub(getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
-
-		case 0xD7:
-			rst(0x0010);
-			addCycles(16);
-			break;
-
-		case 0xD8:
-			if (getFlag(CARRY_FLAG)) {
-				ret();
-				addCycles(20);
-			}
-			else {
-				addCycles(8);
-				PC += 1;
-			}
-			break;
-
-		//reti
-		case 0xD9:
-			IME = 1;
-			ret();
-			addCycles(16);
-			break;
-
-		case 0xDA:
-			if (getFlag(CARRY_FLAG)) {
-				jp(getWordPC());
-				addCycles(16);
-			}
-			else {
-				addCycles(12);
-				PC += 3;
-			}
-			break;
-
-		case 0xDC:
-			if (getFlag(CARRY_FLAG)) {
-				call(getWordPC());
-				addCycles(24);
-			}
-			else {
-				addCycles(12);
-				PC += 3;
-			}
-			break;
-
-		case 0xDE:
-			sbc(getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
-
-		case 0xDF:
-			rst(0x18);
-			addCycles(16);
-			break;
-
-		case 0xE0:
-			ld(addressSpace[0xFF00 + getBytePC()], AF.hi);
-			PC += 2;
-			addCycles(12);
-			break;
-
-		case 0xE1:
-			pop(HL.reg);
-			PC += 1;
-			addCycles(12);
-			break;
-
-		case 0xE2:
-			ld(addressSpace[0xFF00 + BC.lo], AF.hi);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0xE5:
-			push(HL.reg);
-			PC += 1;
-			addCycles(16);
-			break;
-
-		case 0xE6:
-			andBitwise(AF.hi, getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
-
-		case 0xE7:
-			rst(0x0020);
-			addCycles(16);
-			break;
-
-		case 0xE8:
-			{
-				const int16_t immediate = static_cast<int8_t>(getBytePC());
-
-				if ((SP & 0xF) + (immediate & 0xF) > 0xF)
-					setFlag(HALFCARRY_FLAG);
-				else
-					resetFlag(HALFCARRY_FLAG);
-
-				if ((SP & 0xFF) + (immediate & 0xFF) > 0xFF)
-					setFlag(CARRY_FLAG);
-				else
-					resetFlag(CARRY_FLAG);
-
-				SP += immediate;
-
-				resetFlag(ZERO_FLAG);
-				resetFlag(SUBTRACT_FLAG);
-
-				PC += 2;
-				addCycles(16);
-			}
-			break;
-
-		case 0xE9:
-			jp(HL.reg);
-			addCycles(16);
-			break;
-
-		case 0xEA:
-			ld(addressSpace[getWordPC()], AF.hi);
-			PC += 3;
-			addCycles(16);
-			break;
-
-		case 0xEE:
-			xorBitwise(AF.hi, getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
-
-		case 0xEF:
-			rst(0x28);
-			addCycles(16);
-			break;
-
-		case 0xF0:
-			ld(AF.hi, readOnlyAddressSpace[0xFF00 + getBytePC()]);
-			PC += 2;
-			addCycles(12);
-			break;
-
-		case 0xF1:
-			pop(AF.reg);
-			PC += 1;
-			addCycles(12);
-			break;
-
-		case 0xF2:
-			ld(AF.hi, readOnlyAddressSpace[0xFF00 + BC.lo]);
-			PC += 1;
-			addCycles(12);
-			break;
-
-		case 0xF3:
-			IME = 0;
-			PC += 1;
-			addCycles(4);
-			break;
-
-		case 0xF5:
-			push(AF.reg);
-			PC += 1;
-			addCycles(16);
-			break;
-
-		case 0xF6:
-			orBitwise(AF.hi, getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
-
-		case 0xF7:
-			rst(0x0030);
-			addCycles(16);
-			break;
-
-		case 0xF8:
-			{
-				const int16_t immediate = static_cast<int8_t>(getBytePC());
-				HL.reg = SP + immediate;
-
-				if ((SP & 0xF) + (immediate & 0xF) > 0xF)
-					setFlag(HALFCARRY_FLAG);
-				else
-					resetFlag(HALFCARRY_FLAG);
-
-
-				if ((SP & 0xFF) + (immediate & 0xFF) > 0xFF)
-					setFlag(CARRY_FLAG);
-				else
-					resetFlag(CARRY_FLAG);
-
-
-				resetFlag(ZERO_FLAG);
-				resetFlag(SUBTRACT_FLAG);
-
-				PC += 2;
-				addCycles(12);
-			}
-			break;
-
-		case 0xF9:
-			ld(SP, HL.reg);
-			PC += 1;
-			addCycles(8);
-			break;
-
-		case 0xFA:
-			ld(AF.hi, readOnlyAddressSpace[getWordPC()]);
-			PC += 3;
-			addCycles(16);
-			break;
-
-		//EI (0xFB) then DI (0xF3) never allows interrupts to happen
-		case 0xFB:
-			IME = 0;
-			IME_togge = true;
-			PC += 1;
-			addCycles(4);
-			break;
-
-		case 0xFE:
-			cp(getBytePC());
-			PC += 2;
-			addCycles(8);
-			break;
-
-		case 0xFF:
-			rst(0x38);
-			addCycles(16);
-			break;
-
-		default:
-			printf("Unsupported opcode found: PC:0x%.2x, Opcode:0x%.2x\n", PC, addressSpace[PC]);
-			exit(1);
-		}
+template <>
+void GameBoy::executeOpcode<0x8F>() {
+	adc(AF.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x90>() {
+	sub(BC.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x91>() {
+	sub(BC.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x92>() {
+	sub(DE.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x93>() {
+	sub(DE.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x94>() {
+	sub(HL.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x95>() {
+	sub(HL.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x96>() {
+	sub(read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0x97>() {
+	sub(AF.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x98>() {
+	sbc(BC.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x99>() {
+	sbc(BC.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x9A>() {
+	sbc(DE.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x9B>() {
+	sbc(DE.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x9C>() {
+	sbc(HL.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x9D>() {
+	sbc(HL.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0x9E>() {
+	sbc(read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0x9F>() {
+	sbc(AF.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xA0>() {
+	andBitwise(AF.hi, BC.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xA1>() {
+	andBitwise(AF.hi, BC.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xA2>() {
+	andBitwise(AF.hi, DE.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xA3>() {
+	andBitwise(AF.hi, DE.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xA4>() {
+	andBitwise(AF.hi, HL.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xA5>() {
+	andBitwise(AF.hi, HL.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xA6>() {
+	andBitwise(AF.hi, read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xA7>() {
+	andBitwise(AF.hi, AF.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xA8>() {
+	xorBitwise(AF.hi, BC.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xA9>() {
+	xorBitwise(AF.hi, BC.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xAA>() {
+	xorBitwise(AF.hi, DE.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xAB>() {
+	xorBitwise(AF.hi, DE.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xAC>() {
+	xorBitwise(AF.hi, HL.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xAD>() {
+	xorBitwise(AF.hi, HL.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xAE>() {
+	xorBitwise(AF.hi, read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xAF>() {
+	xorBitwise(AF.hi, AF.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xB0>() {
+	orBitwise(AF.hi, BC.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xB1>() {
+	orBitwise(AF.hi, BC.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xB2>() {
+	orBitwise(AF.hi, DE.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xB3>() {
+	orBitwise(AF.hi, DE.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xB4>() {
+	orBitwise(AF.hi, HL.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xB5>() {
+	orBitwise(AF.hi, HL.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xB6>() {
+	orBitwise(AF.hi, read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xB7>() {
+	orBitwise(AF.hi, AF.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xB8>() {
+	cp(BC.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xB9>() {
+	cp(BC.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xBA>() {
+	cp(DE.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xBB>() {
+	cp(DE.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xBC>() {
+	cp(HL.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xBD>() {
+	cp(HL.lo);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xBE>() {
+	cp(read(HL.reg));
+	PC += 1;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xBF>() {
+	cp(AF.hi);
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xC0>() {
+	//RET NZ
+	if (!getFlag(ZERO_FLAG)) {
+		ret();
+		addCycles(20);
 	}
+	else {
+		addCycles(8);
+		PC += 1;
+	}
+}
+
+template <>
+void GameBoy::executeOpcode<0xC1>() {
+	pop(BC.reg);
+	PC += 1;
+	addCycles(12);
+}
+
+template <>
+void GameBoy::executeOpcode<0xC2>() {
+	if (!getFlag(ZERO_FLAG)) {
+		jp(getWordPC());
+		addCycles(16);
+	}
+	else {
+		addCycles(12);
+		PC += 3;
+	}
+}
+
+template <>
+void GameBoy::executeOpcode<0xC3>() {
+	jp(getWordPC());
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xC4>() {
+	if (!getFlag(ZERO_FLAG)) {
+		call(getWordPC());
+		addCycles(24);
+	}
+	else {
+		addCycles(12);
+		PC += 3;
+	}
+}
+
+template <>
+void GameBoy::executeOpcode<0xC5>() {
+	push(BC.reg);
+	PC += 1;
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xC6>() {
+	add(AF.hi, getBytePC());
+	PC += 2;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xC7>() {
+	rst(0x0000);
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xC8>() {
+	if (getFlag(ZERO_FLAG)) {
+		ret();
+		addCycles(20);
+	}
+	else {
+		addCycles(8);
+		PC += 1;
+	}
+}
+
+template <>
+void GameBoy::executeOpcode<0xC9>() {
+	ret();
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xCA>() {
+	if (getFlag(ZERO_FLAG)) {
+		jp(getWordPC());
+		addCycles(16);
+	}
+	else {
+		addCycles(12);
+		PC += 3;
+	}
+}
+
+template <>
+void GameBoy::executeOpcode<0xCB>() {
+	extendedOpcodeResolver();
+}
+
+template <>
+void GameBoy::executeOpcode<0xCC>() {
+	if (getFlag(ZERO_FLAG)) {
+		call(getWordPC());
+		addCycles(24);
+	}
+	else {
+		addCycles(12);
+		PC += 3;
+	}
+}
+
+template <>
+void GameBoy::executeOpcode<0xCD>() {
+	call(getWordPC());
+	addCycles(24);
+}
+
+template <>
+void GameBoy::executeOpcode<0xCE>() {
+	adc(getBytePC());
+	PC += 2;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xCF>() {
+	rst(0x08);
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xD0>() {
+	//RET NC
+	if (!getFlag(CARRY_FLAG)) {
+		ret();
+		addCycles(20);
+	}
+	else {
+		addCycles(8);
+		PC += 1;
+	}
+}
+
+template <>
+void GameBoy::executeOpcode<0xD1>() {
+	pop(DE.reg);
+	PC += 1;
+	addCycles(12);
+}
+
+template <>
+void GameBoy::executeOpcode<0xD2>() {
+	if (!getFlag(CARRY_FLAG)) {
+		jp(getWordPC());
+		addCycles(24);
+	}
+	else {
+		addCycles(12);
+		PC += 3;
+	}
+}
+
+template <>
+void GameBoy::executeOpcode<0xD4>() {
+	if (!getFlag(CARRY_FLAG)) {
+		call(getWordPC());
+		addCycles(24);
+	}
+	else {
+		addCycles(12);
+		PC += 3;
+	}
+}
+
+template <>
+void GameBoy::executeOpcode<0xD5>() {
+	push(DE.reg);
+	PC += 1;
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xD6>() {
+	sub(getBytePC());
+	PC += 2;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xD7>() {
+	rst(0x0010);
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xD8>() {
+	if (getFlag(CARRY_FLAG)) {
+		ret();
+		addCycles(20);
+	}
+	else {
+		addCycles(8);
+		PC += 1;
+	}
+}
+
+template <>
+void GameBoy::executeOpcode<0xD9>() {
+	//reti
+	IME = 1;
+	scheduleInterruptCheck();
+	ret();
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xDA>() {
+	if (getFlag(CARRY_FLAG)) {
+		jp(getWordPC());
+		addCycles(16);
+	}
+	else {
+		addCycles(12);
+		PC += 3;
+	}
+}
+
+template <>
+void GameBoy::executeOpcode<0xDC>() {
+	if (getFlag(CARRY_FLAG)) {
+		call(getWordPC());
+		addCycles(24);
+	}
+	else {
+		addCycles(12);
+		PC += 3;
+	}
+}
+
+template <>
+void GameBoy::executeOpcode<0xDE>() {
+	sbc(getBytePC());
+	PC += 2;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xDF>() {
+	rst(0x18);
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xE0>() {
+	write(0xFF00 + getBytePC(), AF.hi);
+	PC += 2;
+	addCycles(12);
+}
+
+template <>
+void GameBoy::executeOpcode<0xE1>() {
+	pop(HL.reg);
+	PC += 1;
+	addCycles(12);
+}
+
+template <>
+void GameBoy::executeOpcode<0xE2>() {
+	write(0xFF00 + BC.lo, AF.hi);
+	PC += 1;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xE5>() {
+	push(HL.reg);
+	PC += 1;
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xE6>() {
+	andBitwise(AF.hi, getBytePC());
+	PC += 2;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xE7>() {
+	rst(0x0020);
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xE8>() {
+	const int16_t immediate = static_cast<int8_t>(getBytePC());
+
+	if ((SP & 0xF) + (immediate & 0xF) > 0xF)
+		setFlag(HALFCARRY_FLAG);
+	else
+		resetFlag(HALFCARRY_FLAG);
+
+	if ((SP & 0xFF) + (immediate & 0xFF) > 0xFF)
+		setFlag(CARRY_FLAG);
+	else
+		resetFlag(CARRY_FLAG);
+
+	SP += immediate;
+
+	resetFlag(ZERO_FLAG);
+	resetFlag(SUBTRACT_FLAG);
+
+	PC += 2;
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xE9>() {
+	jp(HL.reg);
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xEA>() {
+	write(getWordPC(), AF.hi);
+	PC += 3;
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xEE>() {
+	xorBitwise(AF.hi, getBytePC());
+	PC += 2;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xEF>() {
+	rst(0x28);
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xF0>() {
+	ld(AF.hi, read(0xFF00 + getBytePC()));
+	PC += 2;
+	addCycles(12);
+}
+
+template <>
+void GameBoy::executeOpcode<0xF1>() {
+	pop(AF.reg);
+	PC += 1;
+	addCycles(12);
+}
+
+template <>
+void GameBoy::executeOpcode<0xF2>() {
+	ld(AF.hi, read(0xFF00 + BC.lo));
+	PC += 1;
+	addCycles(12);
+}
+
+template <>
+void GameBoy::executeOpcode<0xF3>() {
+	IME = 0;
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xF5>() {
+	push(AF.reg);
+	PC += 1;
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xF6>() {
+	orBitwise(AF.hi, getBytePC());
+	PC += 2;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xF7>() {
+	rst(0x0030);
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xF8>() {
+	const int16_t immediate = static_cast<int8_t>(getBytePC());
+	HL.reg = SP + immediate;
+
+	if ((SP & 0xF) + (immediate & 0xF) > 0xF)
+		setFlag(HALFCARRY_FLAG);
+	else
+		resetFlag(HALFCARRY_FLAG);
+
+
+	if ((SP & 0xFF) + (immediate & 0xFF) > 0xFF)
+		setFlag(CARRY_FLAG);
 	else
-		extendedOpcodeResolver();
+		resetFlag(CARRY_FLAG);
+
+
+	resetFlag(ZERO_FLAG);
+	resetFlag(SUBTRACT_FLAG);
+
+	PC += 2;
+	addCycles(12);
+}
+
+template <>
+void GameBoy::executeOpcode<0xF9>() {
+	ld(SP, HL.reg);
+	PC += 1;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xFA>() {
+	ld(AF.hi, read(getWordPC()));
+	PC += 3;
+	addCycles(16);
+}
+
+template <>
+void GameBoy::executeOpcode<0xFB>() {
+	//EI (0xFB) then DI (0xF3) never allows interrupts to happen
+	IME = 0;
+	IME_togge = true;
+	scheduleInterruptCheck();
+	PC += 1;
+	addCycles(4);
+}
+
+template <>
+void GameBoy::executeOpcode<0xFE>() {
+	cp(getBytePC());
+	PC += 2;
+	addCycles(8);
+}
+
+template <>
+void GameBoy::executeOpcode<0xFF>() {
+	rst(0x38);
+	addCycles(16);
+}
+
+//built at compile time, indexed by the opcode byte
+const GameBoy::OpcodeTable GameBoy::opcodeTable = []<std::size_t... opcodes>(std::index_sequence<opcodes...>) {
+	return OpcodeTable{&GameBoy::dispatchOpcode<opcodes>...};
+}(std::make_index_sequence<256>());
+
+void GameBoy::opcodeResolver() {
+	opcodeTable[readOnlyAddressSpace[PC]](*this);
+}
+
+void GameBoy::runInstructions(const bool singleStep) {
+	if (halted) {
+		//only an event can end the HALT, so jump straight to it in whole M-cycles rather than 4 T-cycles a time
+		const uint64_t nextEvent = scheduler.nextEvent();
+		if (singleStep || nextEvent == Scheduler::never || nextEvent <= cycles + 4)
+			addCycles(4);
+		else
+			addCycles((nextEvent - cycles + 3) & ~static_cast<uint64_t>(3));
+		return;
+	}
+#ifdef GBPP_THREADED_DISPATCH
+	//every handler fetches and jumps straight to the next one until an event is due
+#define GBPP_OPCODE_LABEL_ADDRESS(opcode) &&op##opcode,
+#define GBPP_OPCODE_LABEL(opcode) op##opcode: executeOpcode<0x##opcode>(); \
+	if (singleStep || halted || cycles >= scheduler.nextEvent()) \
+		return; \
+	goto *dispatchTable[readOnlyAddressSpace[PC]];
+	static void* const dispatchTable[256] = {GBPP_OPCODE_LIST(GBPP_OPCODE_LABEL_ADDRESS)};
+	goto *dispatchTable[readOnlyAddressSpace[PC]];
+	GBPP_OPCODE_LIST(GBPP_OPCODE_LABEL)
+#undef GBPP_OPCODE_LABEL
+#undef GBPP_OPCODE_LABEL_ADDRESS
+#else
+	do
+		opcodeTable[readOnlyAddressSpace[PC]](*this);
+	while (!singleStep && !halted && cycles < scheduler.nextEvent());
+#endif
 }
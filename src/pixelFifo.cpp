@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cstring>
+#include "gameboy.hpp"
+#include "scanlineRenderer.hpp"
+
+//Only built with GBPP_PIXEL_FIFO_PPU. Mode 3 of each visible line runs the BG/window fetcher, the two pixel
+//FIFOs and object fetches a dot at a time, so its length varies with SCX, the window and objects like on
+//hardware and register, VRAM and OAM writes land on the pixel they happen at. Nothing runs ahead of the CPU:
+//the FIFO is caught up to the current dot on PPU events and before writes that could change what it draws
+
+//the first tile fetch is thrown away, with it a plain line takes MODE3_MIN_DURATION dots
+#define FIFO_START_DOTS (MODE3_MIN_DURATION - RESOLUTION_X - 5)
+#define FIFO_FETCH_DOTS 6 //tile ID, low and high bit plane, 2 dots each
+#define FIFO_OBJECT_FETCH_DOTS 6
+
+void GameBoy::fifoStartLine() {
+	const auto& registers = readOnlyAddressSpace.memoryLayout;
+	fifo = {};
+	if (registers.LY >= RESOLUTION_Y)
+		return;
+	fifo.active = true;
+	fifo.startDots = FIFO_START_DOTS;
+	fifo.discard = registers.SCX % 8;
+	//objects were picked during mode 2, in the order they're reached
+	fifo.objectCount = objectIndex.objectsOnLine(registers.LY, fifo.objects);
+}
+
+void GameBoy::fifoCatchUp() {
+	//checkPPUMode switches to mode 3 once strictly more than MODE2_DURATION cycles into the line
+	const uint64_t target = cyclesSinceLastScanline() - (MODE2_DURATION + 1);
+	while (fifo.active && fifo.x < RESOLUTION_X && fifo.dot < target)
+		fifoTick();
+}
+
+void GameBoy::fifoTick() {
+	const auto& registers = readOnlyAddressSpace.memoryLayout;
+	fifo.dot++;
+	if (fifo.startDots) {
+		fifo.startDots--;
+		return;
+	}
+	if (fifo.objectFetchDots) {
+		if (--fifo.objectFetchDots == 0)
+			fifoFetchObject();
+		return;
+	}
+
+	//reaching WX restarts the fetcher on the window, dropping what's left of the BG. A WX already passed waits
+	//for the next line
+	if (!fifo.window && !fifo.discard && LCDCBitEnabled(BG_WINDOW_ENABLE) && LCDCBitEnabled(WINDOW_ENABLE) &&
+		fifo.x + 7 == registers.WX && registers.LY >= registers.WY) {
+		fifo.window = true;
+		fifo.windowDrawn = true;
+		fifo.bgCount = 0;
+		fifo.fetcherDot = 0;
+		fifo.fetcherX = 0;
+	}
+
+	//an object starting at this pixel waits for the BG fetch in flight, then stalls the FIFOs while it's fetched
+	const bool objectDue = LCDCBitEnabled(OBJ_ENABLE) && fifo.nextObject < fifo.objectCount &&
+		registers.oam[fifo.objects[fifo.nextObject] * 4 + 1] <= fifo.x + 8;
+	if (objectDue && fifo.bgCount) {
+		fifo.objectFetchDots = FIFO_OBJECT_FETCH_DOTS;
+		return;
+	}
+
+	fifo.fetcherDot = std::min(fifo.fetcherDot + 1, FIFO_FETCH_DOTS);
+	//the fetcher only pushes into an empty BG FIFO
+	if (fifo.fetcherDot == FIFO_FETCH_DOTS && !fifo.bgCount) {
+		fifoPushTile();
+		fifo.fetcherDot = 0;
+		fifo.fetcherX++;
+	}
+	if (!fifo.bgCount || objectDue)
+		return;
+
+	const Byte bgIndex = fifo.bg[8 - fifo.bgCount--];
+	const Byte objPixel = fifo.obj[0];
+	std::copy(fifo.obj.begin() + 1, fifo.obj.end(), fifo.obj.begin());
+	fifo.obj[7] = 0;
+	if (fifo.discard) {
+		fifo.discard--;
+		return;
+	}
+
+	//same rules as the composer, but through the palettes as they are on this dot
+	const bool bgEnabled = LCDCBitEnabled(BG_WINDOW_ENABLE);
+	Byte shade = bgEnabled ? registers.BGP >> bgIndex * 2 & 0x03 : 0;
+	const Byte objIndex = objPixel & 0x03;
+	if (objIndex && !(objPixel & OBJ_LINE_BG_OVER_OBJ && bgEnabled && bgIndex)) {
+		const Byte palette = objPixel & OBJ_LINE_PALETTE ? registers.OBP1 : registers.OBP0;
+		shade = palette >> objIndex * 2 & 0x03;
+	}
+	fifo.shades[fifo.x++] = shade;
+}
+
+//the whole fetch is read on the dot it's pushed
+void GameBoy::fifoPushTile() {
+	const auto& registers = readOnlyAddressSpace.memoryLayout;
+	uint16_t mapAddr;
+	uint16_t mapOffset;
+	uint8_t tileY;
+	if (fifo.window) {
+		mapAddr = LCDCBitEnabled(WINDOW_TILE_MAP_AREA) ? 0x9C00 : 0x9800;
+		mapOffset = (windowLineCounter / 8) << 5 | (fifo.fetcherX & 0x1F);
+		tileY = windowLineCounter % 8;
+	}
+	else {
+		const uint8_t bgY = registers.LY + registers.SCY;
+		mapAddr = LCDCBitEnabled(BG_TILE_MAP_AREA) ? 0x9C00 : 0x9800;
+		mapOffset = (bgY / 8) << 5 | ((registers.SCX / 8 + fifo.fetcherX) & 0x1F);
+		tileY = bgY % 8;
+	}
+	const Byte tileID = registers.vram[mapAddr - 0x8000 + mapOffset];
+	const uint16_t tile = LCDCBitEnabled(BG_WINDOW_TILE_DATA_AREA) ? tileID : 128 + ((tileID + 128) % 256);
+	std::memcpy(fifo.bg.data(), tileCache.row(registers.vram, tile, tileY), 8);
+	fifo.bgCount = 8;
+}
+
+void GameBoy::fifoFetchObject() {
+	const auto& registers = readOnlyAddressSpace.memoryLayout;
+	const Byte* object = registers.oam + fifo.objects[fifo.nextObject++] * 4;
+	const int spriteHeight = LCDCBitEnabled(OBJ_SIZE) ? 16 : 8;
+	const Byte attributes = object[3];
+
+	Byte objectY = registers.LY - (object[0] - 16);
+	if (oamBitEnabled(attributes, Y_FLIP))
+		objectY = (spriteHeight - 1) - objectY;
+	const uint16_t objectTile = spriteHeight == 8 ? object[2] : (object[2] & 0xFE) + objectY / 8 % 2;
+	const Byte* tileRow = tileCache.row(registers.vram, objectTile, objectY % 8);
+	const bool xFlip = oamBitEnabled(attributes, X_FLIP);
+	const Byte objBits = (oamBitEnabled(attributes, OBJ_PALETTE) ? OBJ_LINE_PALETTE : 0) |
+		(oamBitEnabled(attributes, PRIORITY) ? OBJ_LINE_BG_OVER_OBJ : 0);
+
+	//objects are reached in priority order, so one only fills the slots still transparent
+	const int firstSlot = object[1] - 8 - fifo.x;
+	for (int x = 0; x < 8; x++) {
+		const int slot = firstSlot + x;
+		const Byte colorIndex = tileRow[xFlip ? 7 - x : x];
+		if (slot >= 0 && slot < 8 && colorIndex != 0 && (fifo.obj[slot] & 0x03) == 0)
+			fifo.obj[slot] = colorIndex | objBits;
+	}
+}
+
+void GameBoy::fifoFinishLine() {
+	const uint8_t line = readOnlyAddressSpace.memoryLayout.LY;
+	fifo.active = false;
+	if (fifo.windowDrawn)
+		windowLineCounter += 1;
+	if (!renderingFrame)
+		return;
+
+	//the shades are already final, the composer only has to turn them into the pixel format
+	std::array<uint32_t, 16> shadePixels = {};
+	for (int shade = 0; shade < 4; shade++)
+		shadePixels[shade] = shadeToPixel(shade, pixelFormat);
+	const Byte noObjects[RESOLUTION_X] = {};
+	const int rowBytes = scanlineBytes(pixelFormat);
+	Byte pixels[RESOLUTION_X * 4];
+	composeScanlineScalar(fifo.shades.data(), noObjects, shadePixels.data(), pixelFormat, pixels);
+	Byte* row = framebuffer.data() + line * rowBytes;
+	if (std::memcmp(row, pixels, rowBytes) != 0) {
+		std::memcpy(row, pixels, rowBytes);
+		dirtyLines.set(line);
+	}
+}
@@ -1,10 +1,15 @@
 #include "gameboy.hpp"
 #include "defines.hpp"
+#include "scanlineRenderer.hpp"
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <utility>
 
+//picked once for the host CPU
+static const ScanlineComposer composeScanline = selectScanlineComposer();
+
 bool GameBoy::LCDCBitEnabled(const Byte bit) const {
 	return readOnlyAddressSpace.memoryLayout.LCDC & static_cast<Byte>(1 << bit);
 }
@@ -13,19 +18,76 @@ bool GameBoy::oamBitEnabled(const Byte oamAttributeByte, const Byte bit) {
 	return oamAttributeByte & static_cast<Byte>(1 << bit);
 }
 
-unsigned int GameBoy::getColourFromPalette(const Byte palette) {
-	switch (palette & 0x3) {
-	case 0:
-		return WHITE;
-	case 1:
-		return LIGHT_GRAY;
-	case 2:
-		return DARK_GRAY;
-	case 3:
-		return BLACK;
-	default:
-		std::unreachable();
+void GameBoy::LCDCWrite() {
+	const bool enabled = LCDCBitEnabled(LCD_ENABLE);
+	if (ppuEnabled && !enabled) {
+		//switching the LCD off resets LY and holds the PPU in mode 0
+		ppuCycles = 2;
+		lastScanline = 0;
+		lastRefresh = 0;
+		addressSpace.memoryLayout.LY = 0x00;
+		addressSpace.memoryLayout.STAT &= 0xfc;
+		scheduler.cancel(ppuEvent);
+#ifdef GBPP_PIXEL_FIFO_PPU
+		fifo.active = false;
+#endif
+	}
+	else if (!ppuEnabled && enabled) {
+		scheduler.schedule(ppuEvent, cycles);
+	}
+	ppuEnabled = enabled;
+	const int objectHeight = LCDCBitEnabled(OBJ_SIZE) ? 16 : 8;
+	if (objectHeight != objectIndex.objectHeight()) {
+		renderPendingLines();
+		objectIndex.setHeight(addressSpace.memoryLayout.oam, objectHeight);
+	}
+}
+
+void GameBoy::updatePaletteLUT(const LineState& state) {
+	//BG enable decides whether the BG entries follow BGP
+	const uint32_t key = (state.LCDC & 1 << BG_WINDOW_ENABLE) | state.BGP << 8 | state.OBP0 << 16 | state.OBP1 << 24;
+	if (paletteLUTBuilt && key == paletteLUTKey)
+		return;
+	for (int i = 0; i < 4; i++) {
+		paletteLUT[i] = shadeToPixel(state.LCDC & 1 << BG_WINDOW_ENABLE ? state.BGP >> (i * 2) : 0, pixelFormat);
+		paletteLUT[4 + i] = shadeToPixel(state.OBP0 >> (i * 2), pixelFormat);
+		paletteLUT[8 + i] = shadeToPixel(state.OBP1 >> (i * 2), pixelFormat);
+	}
+	paletteLUTKey = key;
+	paletteLUTBuilt = true;
+}
+
+void GameBoy::STATWrite() {
+	//STAT and LYC feed the STAT interrupt line, re-evaluate it at the end of this instruction
+	if (ppuEnabled)
+		scheduler.schedule(ppuEvent, cycles);
+}
+
+void GameBoy::schedulePPU() {
+	uint64_t modeDuration = 0;
+	switch (currentMode) {
+	case mode0:
+	case mode1:
+		modeDuration = SCANLINE_DURATION;
+		break;
+	case mode2:
+		modeDuration = MODE2_DURATION;
+		break;
+	case mode3:
+		modeDuration = MODE2_DURATION + MODE3_MIN_DURATION;
+#ifdef GBPP_PIXEL_FIFO_PPU
+		//a pixel a dot is the soonest the line can be done, checked again then
+		if (fifo.active)
+			modeDuration = MODE2_DURATION + fifo.dot + std::max(RESOLUTION_X - fifo.x, 1);
+#endif
+		break;
 	}
+	//checkPPUMode switches once strictly more cycles than that have passed since the scanline started
+	const uint64_t cyclesSinceScanline = cyclesSinceLastScanline();
+	if (cyclesSinceScanline > modeDuration)
+		scheduler.schedule(ppuEvent, cycles);
+	else
+		scheduler.schedule(ppuEvent, cycles + modeDuration + 1 - cyclesSinceScanline);
 }
 
 void GameBoy::ppuUpdate() {
@@ -63,6 +125,8 @@ void GameBoy::ppuUpdate() {
 	}
 	if (statInteruptLine && !previousInterruptLine)
 		addressSpace.memoryLayout.IF |= 1 << LCD_STAT_INTERRUPT;
+
+	schedulePPU();
 }
 
 void GameBoy::checkPPUMode() {
@@ -81,11 +145,32 @@ void GameBoy::checkPPUMode() {
 	case 2:
 		if (cyclesSinceScanline > MODE2_DURATION) {
 			setPPUMode(PPUMode::mode3);
+#ifdef GBPP_PIXEL_FIFO_PPU
+			fifoStartLine();
+#endif
 		}
 		break;
 	case 3:
+#ifdef GBPP_PIXEL_FIFO_PPU
+		//mode 3 lasts until the FIFO has shifted the whole line out
+		if (fifo.active) {
+			fifoCatchUp();
+			if (fifo.x == RESOLUTION_X) {
+				fifoFinishLine();
+				setPPUMode(PPUMode::mode0);
+			}
+			break;
+		}
+#endif
 		if (cyclesSinceScanline > MODE2_DURATION + MODE3_MIN_DURATION) {
-			drawLine();
+#ifndef GBPP_PIXEL_FIFO_PPU
+			//lines 145-153 also pass through mode 3 here but are never shown
+			if (readOnlyAddressSpace.memoryLayout.LY < RESOLUTION_Y) {
+				if (renderingFrame)
+					recordLine();
+				advanceWindowLine();
+			}
+#endif
 			setPPUMode(PPUMode::mode0);
 		}
 		break;
@@ -98,15 +183,62 @@ void GameBoy::incLY() {
 	if (addressSpace.memoryLayout.LY > SCANLINES_PER_FRAME - 1) {
 		addressSpace.memoryLayout.LY = 0;
 		windowLineCounter = 0;
+		//a request is used up once the frame it was for starts, one made too late for this frame carries over
+		if (renderingFrame)
+			renderRequested = false;
 	}
 	else if (addressSpace.memoryLayout.LY == 144) {
 		// VBlank Period
-		SDL2present();
+		rendered = true;
+		lastFrameDrawn = renderingFrame;
+		frameCount++;
+		renderingFrame = wouldRenderFrame();
 		setPPUMode(PPUMode::mode1);
 		addressSpace.memoryLayout.IF |= 0x1;
 	}
 }
 
+bool GameBoy::wouldRenderFrame() const {
+	switch (renderPolicy) {
+	case renderAll:
+		return true;
+	case renderEveryNth:
+		return frameCount % renderInterval == 0;
+	case renderOnRequest:
+		return renderRequested;
+	default:
+		std::unreachable();
+	}
+}
+
+void GameBoy::setRenderPolicy(const RenderPolicy policy, const uint32_t interval) {
+	renderPolicy = policy;
+	renderInterval = interval ? interval : 1;
+}
+
+void GameBoy::requestRender() {
+	renderRequested = true;
+}
+
+bool GameBoy::frameDrawn() const {
+	return lastFrameDrawn;
+}
+
+void GameBoy::setPixelFormat(const PixelFormat format) {
+	if (format == pixelFormat)
+		return;
+	pixelFormat = format;
+	framebuffer.assign(RESOLUTION_Y * scanlineBytes(format), 0);
+	//every row needs drawing again in the new format
+	lineKeysValid.reset();
+	dirtyLines.set();
+	paletteLUTBuilt = false;
+}
+
+PixelFormat GameBoy::getPixelFormat() const {
+	return pixelFormat;
+}
+
 uint64_t GameBoy::cyclesSinceLastScanline() const {
 	const uint64_t difference = ppuCycles - lastScanline;
 	return difference;
@@ -143,248 +275,184 @@ void GameBoy::setPPUMode(const PPUMode mode) {
 	addressSpace.memoryLayout.STAT |= 0x80;
 }
 
-void GameBoy::drawLine() {
+void GameBoy::recordLine() {
 	const uint8_t line = readOnlyAddressSpace.memoryLayout.LY;
+	//still waiting from the last frame
+	if (pendingLines.test(line))
+		renderPendingLines();
+
+	const auto& registers = readOnlyAddressSpace.memoryLayout;
+	lineStates[line] = {
+		registers.LCDC, registers.SCY, registers.SCX, registers.WY, registers.WX, registers.BGP, registers.OBP0,
+		registers.OBP1, windowLineCounter
+	};
+	pendingLines.set(line);
+}
 
-	// Calculate the starting index of the current scanline in the framebuffer
-	const uint32_t lineStartIndex = line * RESOLUTION_X;
-
-	// Pointer to the current line's pixel data in the framebuffer
-	uint32_t* currentLinePixels = framebuffer + lineStartIndex;
-	std::fill_n(currentLinePixels, RESOLUTION_X, 0xFFFFFFFF);
+void GameBoy::advanceWindowLine() {
+	//the window's own line counter only moves on lines it's drawn on, see drawLine()
+	const auto& registers = readOnlyAddressSpace.memoryLayout;
+	const uint8_t line = registers.LY;
+	const int16_t windowX = static_cast<int16_t>(registers.WX - 7);
+	if (LCDCBitEnabled(BG_WINDOW_ENABLE) && LCDCBitEnabled(WINDOW_ENABLE) && windowX >= 0 && windowX < RESOLUTION_X &&
+		line >= registers.WY)
+		windowLineCounter += 1;
+}
 
+void GameBoy::renderPendingLines() {
+	if (pendingLines.none())
+		return;
+	for (int line = 0; line < RESOLUTION_Y; line++) {
+		if (pendingLines.test(line))
+			drawLine(line);
+	}
+	pendingLines.reset();
+}
 
-	const uint16_t backgroundMapAddr = LCDCBitEnabled(BG_TILE_MAP_AREA) ? 0x9C00 : 0x9800;
-	const uint16_t windowMapAddr = LCDCBitEnabled(WINDOW_TILE_MAP_AREA) ? 0x9C00 : 0x9800;
-	const uint16_t tileDataTableAddr = LCDCBitEnabled(BG_WINDOW_TILE_DATA_AREA) ? 0x8000 : 0x8800;
-	const bool signedIndex = !LCDCBitEnabled(BG_WINDOW_TILE_DATA_AREA);
+//what drawLine() draws a line from, gathered first so it can be keyed before anything is drawn
+struct LineObject {
+	int16_t x;
+	uint16_t tile;
+	uint8_t row;
+	Byte attributes;
+};
+
+void GameBoy::drawLine(const uint8_t line) {
+	const LineState& state = lineStates[line];
+	const auto lineLCDCBit = [&state](const Byte bit) {
+		return state.LCDC & static_cast<Byte>(1 << bit);
+	};
+
+	const uint16_t backgroundMapAddr = lineLCDCBit(BG_TILE_MAP_AREA) ? 0x9C00 : 0x9800;
+	const uint16_t windowMapAddr = lineLCDCBit(WINDOW_TILE_MAP_AREA) ? 0x9C00 : 0x9800;
+	const bool signedIndex = !lineLCDCBit(BG_WINDOW_TILE_DATA_AREA);
+	const Byte* vram = readOnlyAddressSpace.memoryLayout.vram;
+	//tile cache index for a BG/window tile ID. 0x8800 addressing puts IDs 128-255 at 0x8800 and 0-127 at 0x9000
+	const auto tileDataIndex = [signedIndex](const Byte tileID) -> uint16_t {
+		return signedIndex ? 128 + ((tileID + 128) % 256) : tileID;
+	};
+
+	//the key covers the line's registers and the tiles and objects it uses, along with the generation of each
+	//tile's data. If it's unchanged since the line was last drawn, the framebuffer row already holds the result
+	uint64_t key = 0;
+	const auto mix = [&key](const uint64_t value) {
+		key = (key ^ value) * 0x9E3779B97F4A7C15ULL;
+		key ^= key >> 29;
+	};
+	mix(static_cast<uint64_t>(state.LCDC) | state.SCY << 8 | state.SCX << 16 | state.WY << 24 |
+		static_cast<uint64_t>(state.WX) << 32 | static_cast<uint64_t>(state.BGP) << 40 |
+		static_cast<uint64_t>(state.OBP0) << 48 | static_cast<uint64_t>(state.OBP1) << 56);
+	mix(state.windowLine);
+	const auto mixTile = [this, &mix](const uint16_t tile) {
+		mix(static_cast<uint64_t>(tile) << 32 | tileCache.generation(tile));
+	};
 
 	//BG
-	if (LCDCBitEnabled(BG_WINDOW_ENABLE)) {
-		for (int pixel = 0; pixel < RESOLUTION_X; pixel++) {
-			const uint16_t xIndex = (pixel + readOnlyAddressSpace.memoryLayout.SCX) % 256;
-			// 256 pixels in total BG width
-			const uint16_t yIndex = (line + readOnlyAddressSpace.memoryLayout.SCY) % 256;
-			// 256 pixels in total BG height
-
-			const uint16_t tileUpper = (yIndex / 8) << 5;
-			const uint16_t tileLower = xIndex / 8 & 0x1F;
-			const uint16_t tileIndex = tileUpper + tileLower;
-
-			const uint16_t tileAddr = backgroundMapAddr + tileIndex;
-			const int16_t tileID = signedIndex
-				                       ? static_cast<int16_t>(readOnlyAddressSpace[tileAddr])
-				                       : readOnlyAddressSpace[tileAddr];
-
-			uint16_t tileDataAddr;
-			if (signedIndex)
-				tileDataAddr = tileDataTableAddr + (((tileID + 128) % 256) << 4); // For signed, wrap around
-			else
-				tileDataAddr = tileDataTableAddr + (tileID * 16);
-
-
-			const uint8_t lineOffset = yIndex % 8;
-			const uint8_t tileRowData1 = readOnlyAddressSpace[tileDataAddr + (lineOffset * 2)];
-			const uint8_t tileRowData2 = readOnlyAddressSpace[tileDataAddr + (lineOffset * 2) + 1];
-
-			//get pixel data (2 bits)
-			const uint8_t colourBit = 7 - (xIndex % 8);
-			const uint8_t colourNum = ((tileRowData2 >> colourBit) & 0x1) << 1 | ((tileRowData1 >> colourBit) & 0x1);
-
-			// Apply the BGP register for palette mapping
-			const uint8_t palette = (readOnlyAddressSpace.memoryLayout.BGP >> (colourNum * 2)) & 0x3;
-
-			currentLinePixels[pixel] = getColourFromPalette(palette);
-		}
-
-		// 	For the window to be displayed on a scanline, the following conditions must be met:
-		// WY condition was triggered: i.e. at some point in this frame the value of WY was equal to LY (checked at the start of Mode 2 only)
-		// WX condition was triggered: i.e. the current X coordinate being rendered + 7 was equal to WX
-		// Window enable bit in LCDC is set
-		//Window
-		const uint8_t windowY = readOnlyAddressSpace.memoryLayout.WY;
-		const int16_t windowX = static_cast<int16_t>(readOnlyAddressSpace.memoryLayout.WX - 7);
-		if (LCDCBitEnabled(WINDOW_ENABLE) && windowX >= 0 && windowX < RESOLUTION_X && line >= windowY) {
-			for (int pixel = windowX; pixel < RESOLUTION_X; pixel++) {
-				const uint16_t yIndex = windowLineCounter;
-				const uint16_t windowTileUpper = (yIndex / 8) << 5;
-
-				const uint16_t xIndex = pixel - windowX;
-				const uint16_t windowTileLower = (xIndex / 8) & 0x1F;
-
-				const uint16_t tileIndex = windowTileUpper + windowTileLower;
-				const uint16_t tileAddr = windowMapAddr + tileIndex;
-
-				const int16_t tileID = signedIndex
-					                       ? static_cast<int16_t>(readOnlyAddressSpace[tileAddr])
-					                       : readOnlyAddressSpace[tileAddr];
-
-				uint16_t tileDataAddr;
-				if (signedIndex)
-					tileDataAddr = tileDataTableAddr + (((tileID + 128) % 256) * 16); // For signed, wrap around
-				else
-					tileDataAddr = tileDataTableAddr + (tileID * 16);
-
-
-				const uint8_t lineOffset = yIndex % 8;
-				const uint8_t tileRowData1 = readOnlyAddressSpace[tileDataAddr + (lineOffset * 2)];
-				const uint8_t tileRowData2 = readOnlyAddressSpace[tileDataAddr + (lineOffset * 2) + 1];
-
-				//get pixel data (2 bits)
-				const uint8_t colourBit = 7 - (xIndex % 8);
-				const uint8_t colourNum = ((tileRowData2 >> colourBit) & 0x1) << 1 | ((tileRowData1 >> colourBit) &
-					0x1);
-
-				// Apply the BGP register for palette mapping
-				const uint8_t palette = (readOnlyAddressSpace.memoryLayout.BGP >> (colourNum * 2)) & 0x3;
-
-				currentLinePixels[pixel] = getColourFromPalette(palette);
-			}
-			windowLineCounter += 1;
+	std::array<uint16_t, RESOLUTION_X / 8 + 1> bgTiles;
+	const uint16_t bgY = (line + state.SCY) % 256; // 256 pixels in total BG height
+	if (lineLCDCBit(BG_WINDOW_ENABLE)) {
+		const uint16_t tileUpper = (bgY / 8) << 5;
+		//21 whole tile rows, the first starting up to 7 pixels left of the screen
+		for (int tile = 0; tile <= RESOLUTION_X / 8; tile++) {
+			const uint16_t tileLower = (state.SCX / 8 + tile) & 0x1F; // 256 pixels in total BG width
+			bgTiles[tile] = tileDataIndex(vram[backgroundMapAddr - 0x8000 + tileUpper + tileLower]);
+			mixTile(bgTiles[tile]);
 		}
 	}
-	// oam/sprites
-	if (LCDCBitEnabled(OBJ_ENABLE)) {
-		uint32_t oamPixels[RESOLUTION_X];
-		std::fill_n(oamPixels, RESOLUTION_X, 0);
-
-		constexpr
-			Word oamAddrStart = 0xFE00;
-		const int spriteHeight = LCDCBitEnabled(OBJ_SIZE) ? 16 : 8;
-
-		int objects[10] = {0};
-		int found = 0;
-
-		//oam hold 40 objects
-		//find first 10
-		for (int i = 0; i < 40 && found < 10; i++) {
-			const int offset = i * 4;
-			const int yPos = readOnlyAddressSpace[oamAddrStart + offset] - 16;
-
-			if (line >= yPos && line <= yPos + spriteHeight - 1) {
-				objects[found] = oamAddrStart + offset;
-				found += 1;
-			}
-		}
 
-		//sort by xPos (lower has higher priority when rendering) and then earlier objects
-		for (int i = 0; i < found; i++) {
-			for (int j = 0; j < found - i - 1; j++) {
-				const int xPos1 = readOnlyAddressSpace[objects[j] + 1];
-				const int xPos2 = readOnlyAddressSpace[objects[j + 1] + 1];
-
-				if (xPos1 > xPos2) {
-					const int tmp = objects[j];
-					objects[j] = objects[j + 1];
-					objects[j + 1] = tmp;
-				}
-			}
+	// 	For the window to be displayed on a scanline, the following conditions must be met:
+	// WY condition was triggered: i.e. at some point in this frame the value of WY was equal to LY (checked at the start of Mode 2 only)
+	// WX condition was triggered: i.e. the current X coordinate being rendered + 7 was equal to WX
+	// Window enable bit in LCDC is set
+	//Window
+	std::array<uint16_t, RESOLUTION_X / 8> windowTiles;
+	int windowTileCount = 0;
+	const int16_t windowX = static_cast<int16_t>(state.WX - 7);
+	if (lineLCDCBit(BG_WINDOW_ENABLE) && lineLCDCBit(WINDOW_ENABLE) && windowX >= 0 && windowX < RESOLUTION_X &&
+		line >= state.WY) {
+		const uint16_t windowTileUpper = (state.windowLine / 8) << 5;
+		for (; windowX + windowTileCount * 8 < RESOLUTION_X; windowTileCount++) {
+			windowTiles[windowTileCount] = tileDataIndex(vram[windowMapAddr - 0x8000 + windowTileUpper + windowTileCount]);
+			mixTile(windowTiles[windowTileCount]);
 		}
+	}
 
-
-		for (int objectIndex = found - 1; objectIndex >= 0; objectIndex--) {
-			const int yPos = readOnlyAddressSpace[objects[objectIndex]] - 16;
-			const int xPos = readOnlyAddressSpace[objects[objectIndex] + 1] - 8;
-			const int tileIndex = readOnlyAddressSpace[objects[objectIndex] + 2];
-			const Byte attributes = readOnlyAddressSpace[objects[objectIndex] + 3];
-
-			const bool priority = oamBitEnabled(attributes, PRIORITY);
-			const bool yFlip = oamBitEnabled(attributes, Y_FLIP);
-			const bool xFlip = oamBitEnabled(attributes, X_FLIP);
-			//get obp0 or obj1
-			const Byte objPalette = oamBitEnabled(attributes, OBJ_PALETTE)
-				                        ? addressSpace.memoryLayout.OBP1
-				                        : addressSpace.memoryLayout.OBP0;
-
-			for (int pixel = xPos; pixel < RESOLUTION_X && pixel < xPos + 8; pixel++) {
-				constexpr
-					Word objectTileAddr = 0x8000;
-				if (pixel < 0)
-					continue;
-
-				const uint32_t colour = currentLinePixels[pixel];
-				const Byte BGP = readOnlyAddressSpace.memoryLayout.BGP;
-				if (priority && (colour == getColourFromPalette((BGP >> 2) & 0x3) ||
-					colour == getColourFromPalette((BGP >> 4) & 0x3) ||
-					colour == getColourFromPalette((BGP >> 6) & 0x3)
-				)) {
-					oamPixels[pixel] = colour;
-					continue;
-				}
-
-				Byte objectX = pixel - xPos;
-				Byte objectY = line - yPos;
-				if (xFlip)
-					objectX = 7 - objectX;
-				if (yFlip)
-					objectY = (spriteHeight - 1) - objectY;
-
-				const Word objTileDataAddr = spriteHeight == 8
-					                             ? objectTileAddr + (tileIndex * 16)
-					                             : objectTileAddr + ((tileIndex & 0xFE) * 16);
-
-				const Byte tileRow = objectY * 2;
-				const Byte tileRowData1 = readOnlyAddressSpace[objTileDataAddr + tileRow];
-				const Byte tileRowData2 = readOnlyAddressSpace[objTileDataAddr + tileRow + 1];
-
-				const int bit = 7 - objectX;
-				const int colorIndex = ((tileRowData2 >> bit) & 1) << 1 | ((tileRowData1 >> bit) & 1);
-
-				// 0 is always transparent
-				if (colorIndex != 0) {
-					const uint8_t paletteColor = (objPalette >> (colorIndex * 2)) & 0x3;
-					const uint32_t finalColor = getColourFromPalette(paletteColor);
-					oamPixels[pixel] = finalColor;
-				}
-				else if (oamPixels[pixel] == 0) {
-					oamPixels[pixel] = currentLinePixels[pixel];
-				}
-			}
+	// oam/sprites
+	std::array<LineObject, OBJECTS_PER_LINE> lineObjects;
+	int lineObjectCount = 0;
+	if (lineLCDCBit(OBJ_ENABLE)) {
+		const int spriteHeight = lineLCDCBit(OBJ_SIZE) ? 16 : 8;
+		const Byte* oam = readOnlyAddressSpace.memoryLayout.oam;
+		std::array<uint8_t, OBJECTS_PER_LINE> objects;
+		const int found = objectIndex.objectsOnLine(line, objects);
+
+		for (int slot = 0; slot < found; slot++) {
+			const Byte* object = oam + objects[slot] * 4;
+			const int yPos = object[0] - 16;
+			const int xPos = object[1] - 8;
+			const int tileIndex = object[2];
+			const Byte attributes = object[3];
+			if (xPos >= RESOLUTION_X)
+				continue;
+
+			Byte objectY = line - yPos;
+			if (oamBitEnabled(attributes, Y_FLIP))
+				objectY = (spriteHeight - 1) - objectY;
+			//8x16 objects use an even/odd pair of tiles
+			const uint16_t objectTile = spriteHeight == 8 ? tileIndex : (tileIndex & 0xFE) + objectY / 8;
+			lineObjects[lineObjectCount++] = {
+				static_cast<int16_t>(xPos), objectTile, static_cast<uint8_t>(objectY % 8), attributes
+			};
+			mix(static_cast<uint64_t>(xPos & 0xFF) << 24 | objectY % 8 << 16 | attributes << 8 | lineObjectCount);
+			mixTile(objectTile);
 		}
+	}
 
-		//help ensure correct interaction with "BG OVER OBJ" flag
-		for (int i = 0; i < RESOLUTION_X; i++) {
-			if (oamPixels[i] != currentLinePixels[i] && oamPixels[i] != 0)
-				currentLinePixels[i] = oamPixels[i];
+	if (lineKeysValid.test(line) && lineKeys[line] == key)
+		return;
+	lineKeys[line] = key;
+	lineKeysValid.set(line);
+
+	//colour indices for the line, with 8 pixels either side so whole tile rows and objects can be copied in
+	//without clipping
+	Byte bgLine[RESOLUTION_X + 16] = {};
+	Byte objLine[RESOLUTION_X + 16] = {};
+	Byte* bg = bgLine + 8;
+	Byte* obj = objLine + 8;
+
+	if (lineLCDCBit(BG_WINDOW_ENABLE)) {
+		for (int tile = 0; tile <= RESOLUTION_X / 8; tile++)
+			std::memcpy(bg - state.SCX % 8 + tile * 8, tileCache.row(vram, bgTiles[tile], bgY % 8), 8);
+	}
+	for (int tile = 0; tile < windowTileCount; tile++)
+		std::memcpy(bg + windowX + tile * 8, tileCache.row(vram, windowTiles[tile], state.windowLine % 8), 8);
+
+	//highest priority first, a pixel belongs to the first object that's opaque there. Whether it then shows
+	//over the BG is left to the composer
+	for (int slot = 0; slot < lineObjectCount; slot++) {
+		const LineObject& object = lineObjects[slot];
+		const bool xFlip = oamBitEnabled(object.attributes, X_FLIP);
+		const Byte objBits = (oamBitEnabled(object.attributes, OBJ_PALETTE) ? OBJ_LINE_PALETTE : 0) |
+			(oamBitEnabled(object.attributes, PRIORITY) ? OBJ_LINE_BG_OVER_OBJ : 0);
+		const Byte* tileRow = tileCache.row(vram, object.tile, object.row);
+
+		Byte* objPixels = obj + object.x;
+		for (int x = 0; x < 8; x++) {
+			// 0 is always transparent
+			const Byte colorIndex = tileRow[xFlip ? 7 - x : x];
+			if (colorIndex != 0 && (objPixels[x] & 0x03) == 0)
+				objPixels[x] = colorIndex | objBits;
 		}
 	}
-}
-
-void GameBoy::SDL2setup() {
-	SDL_Init(SDL_INIT_EVERYTHING);
-	screen = SDL_CreateWindow("GameBoy++",
-	                          SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
-	                          RESOLUTION_X, RESOLUTION_Y,
-	                          0);
-
-	// Create an SDL renderer to draw on the window
-	renderer = SDL_CreateRenderer(screen, -1, SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_ACCELERATED);
 
-	// Create an SDL texture to hold the framebuffer data
-	texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
-	                            SDL_TEXTUREACCESS_STREAMING, RESOLUTION_X, RESOLUTION_Y);
-}
-
-void GameBoy::SDL2destroy() const {
-	SDL_DestroyTexture(texture);
-	SDL_DestroyRenderer(renderer);
-	SDL_DestroyWindow(screen);
-	SDL_Quit();
-}
-
-void GameBoy::SDL2present() {
-	SDL_UpdateTexture(texture, nullptr, framebuffer, RESOLUTION_X * sizeof(uint32_t));
-	SDL_RenderClear(renderer);
-	SDL_RenderCopy(renderer, texture, nullptr, nullptr);
-
-
-	frameTime = SDL_GetTicks() - frameStart;
-
-	if (frameDelay > frameTime) {
-		SDL_Delay(frameDelay - frameTime);
+	//a new key can still give the same pixels, only rows that really changed are reported dirty
+	updatePaletteLUT(state);
+	const int rowBytes = scanlineBytes(pixelFormat);
+	Byte pixels[RESOLUTION_X * 4];
+	composeScanline(bg, obj, paletteLUT.data(), pixelFormat, pixels);
+	Byte* row = framebuffer.data() + line * rowBytes;
+	if (std::memcmp(row, pixels, rowBytes) != 0) {
+		std::memcpy(row, pixels, rowBytes);
+		dirtyLines.set(line);
 	}
-
-	SDL_RenderPresent(renderer);
-	frameStart = SDL_GetTicks();
-	rendered = true;
 }
@@ -0,0 +1,217 @@
+#include "rewindBuffer.hpp"
+#include <algorithm>
+
+//a literal run is a control byte of its length - 1 (0x00-0x7F) followed by the bytes. A run of zeros, bytes
+//that didn't change, is two bytes: 0x80 | the high bits of its length - 1 and then the low bits
+#define REWIND_LITERAL_MAX 0x80
+#define REWIND_ZERO_RUN_MAX 0x8000
+
+static Byte packInput(const Input& input) {
+	return input.UP | input.DOWN << 1 | input.LEFT << 2 | input.RIGHT << 3 | input.B << 4 | input.A << 5 |
+		input.START << 6 | input.SELECT << 7;
+}
+
+static Input unpackInput(const Byte bits) {
+	return {
+		static_cast<bool>(bits & 0x01), static_cast<bool>(bits & 0x02), static_cast<bool>(bits & 0x04),
+		static_cast<bool>(bits & 0x08), static_cast<bool>(bits & 0x10), static_cast<bool>(bits & 0x20),
+		static_cast<bool>(bits & 0x40), static_cast<bool>(bits & 0x80)
+	};
+}
+
+//data XOR reference (or data as is without one) run length coded into out, returns the coded size
+static size_t encodeDelta(const Byte* data, const Byte* reference, const size_t size, Byte* out) {
+	const auto delta = [data, reference](const size_t i) -> Byte {
+		return reference ? data[i] ^ reference[i] : data[i];
+	};
+	size_t written = 0;
+	size_t i = 0;
+	while (i < size) {
+		size_t zeros = 0;
+		while (i + zeros < size && zeros < REWIND_ZERO_RUN_MAX && delta(i + zeros) == 0)
+			zeros++;
+		//a single zero is cheaper as a literal
+		if (zeros >= 2) {
+			out[written++] = 0x80 | (zeros - 1) >> 8;
+			out[written++] = (zeros - 1) & 0xFF;
+			i += zeros;
+			continue;
+		}
+		//literals up to the next run of zeros
+		const size_t control = written++;
+		size_t length = 0;
+		do {
+			out[written++] = delta(i++);
+			length++;
+		}
+		while (i < size && length < REWIND_LITERAL_MAX && !(delta(i) == 0 && i + 1 < size && delta(i + 1) == 0));
+		out[control] = length - 1;
+	}
+	return written;
+}
+
+//XORs a coded delta into out
+static void applyDelta(const Byte* in, const size_t size, Byte* out) {
+	size_t i = 0;
+	while (i < size) {
+		const Byte control = in[i++];
+		if (control & 0x80) {
+			out += ((control & 0x7F) << 8 | in[i++]) + 1;
+			continue;
+		}
+		const size_t length = control + 1;
+		for (size_t j = 0; j < length; j++)
+			out[j] ^= in[i + j];
+		i += length;
+		out += length;
+	}
+}
+
+RewindBuffer::RewindBuffer(const size_t memoryCap, const uint32_t depth, const uint32_t interval,
+                           const uint32_t keyframeInterval) :
+	interval(interval ? interval : 1), keyframeInterval(keyframeInterval ? keyframeInterval : 1), arena(memoryCap),
+	snapshots(depth ? depth : 1), inputs(snapshots.size() * this->interval) {
+}
+
+RewindBuffer::Snapshot& RewindBuffer::snapshot(const size_t index) {
+	return snapshots[(oldest + index) % snapshots.size()];
+}
+
+void RewindBuffer::dropOldest() {
+	//the deltas after a keyframe go with it
+	do {
+		oldest = (oldest + 1) % snapshots.size();
+		count--;
+	}
+	while (count && !snapshot(0).keyframe);
+	if (count == 0)
+		needKeyframe = true;
+}
+
+bool RewindBuffer::allocate(const size_t size, size_t& offset) {
+	if (size > arena.size())
+		return false;
+	while (true) {
+		if (count == 0) {
+			offset = 0;
+			return true;
+		}
+		const Snapshot& first = snapshot(0);
+		const Snapshot& last = snapshot(count - 1);
+		const size_t end = last.offset + last.size;
+		if (first.offset < end) {
+			//not wrapped, free space at the end then at the start
+			if (end + size <= arena.size()) {
+				offset = end;
+				return true;
+			}
+			if (size <= first.offset) {
+				offset = 0;
+				return true;
+			}
+		}
+		else if (end + size <= first.offset) {
+			offset = end;
+			return true;
+		}
+		dropOldest();
+	}
+}
+
+void RewindBuffer::decode(const size_t index) {
+	//the oldest snapshot is always a keyframe
+	size_t key = index;
+	while (!snapshot(key).keyframe)
+		key--;
+	std::ranges::fill(state, 0);
+	applyDelta(arena.data() + snapshot(key).offset, snapshot(key).size, state.data());
+	if (key != index)
+		applyDelta(arena.data() + snapshot(index).offset, snapshot(index).size, state.data());
+}
+
+void RewindBuffer::record(const GameBoy& gameboy, const Input& input) {
+	const size_t size = gameboy.saveStateSize();
+	if (size != stateSize) {
+		//a different cartridge, nothing recorded so far applies
+		clear();
+		stateSize = size;
+		state.resize(size);
+		keyframe.resize(size);
+		encoded.resize(size + size / REWIND_LITERAL_MAX + 1);
+	}
+	//snapshots too big for the arena get skipped, which can leave one older than the inputs kept to replay it
+	while (count && frame - snapshot(0).frame >= inputs.size())
+		dropOldest();
+
+	if (count == 0 || frame - snapshot(count - 1).frame >= interval) {
+		gameboy.saveState(state);
+		const bool isKeyframe = needKeyframe || sinceKeyframe + 1 >= keyframeInterval;
+		const size_t codedSize = encodeDelta(state.data(), isKeyframe ? nullptr : keyframe.data(), size,
+		                                     encoded.data());
+		if (count == snapshots.size())
+			dropOldest();
+		size_t offset;
+		//a delta is useless if making room dropped its keyframe
+		if (allocate(codedSize, offset) && (isKeyframe || count)) {
+			std::copy_n(encoded.data(), codedSize, arena.data() + offset);
+			snapshot(count++) = {frame, offset, codedSize, isKeyframe};
+			if (isKeyframe) {
+				keyframe = state;
+				sinceKeyframe = 0;
+				needKeyframe = false;
+			}
+			else {
+				sinceKeyframe++;
+			}
+		}
+	}
+
+	inputs[frame % inputs.size()] = packInput(input);
+	frame++;
+}
+
+bool RewindBuffer::rewind(GameBoy& gameboy, const uint64_t frames) {
+	if (count == 0)
+		return false;
+	//no further than the frame after the oldest snapshot, so at least one frame is replayed and drawn
+	const uint64_t target = frame - std::min(frames, frame - snapshot(0).frame - 1);
+	//the newest snapshot before the target
+	size_t index = count - 1;
+	while (index > 0 && snapshot(index).frame >= target)
+		index--;
+	decode(index);
+	if (!gameboy.loadState(state)) {
+		clear();
+		return false;
+	}
+	for (uint64_t replayed = snapshot(index).frame; replayed < target; replayed++) {
+		gameboy.setInput(unpackInput(inputs[replayed % inputs.size()]));
+		gameboy.runFrame();
+	}
+
+	//what came after the target won't happen now
+	while (count && snapshot(count - 1).frame > target)
+		count--;
+	frame = target;
+	//the kept snapshots may end on an older keyframe than the one held
+	needKeyframe = true;
+	return true;
+}
+
+void RewindBuffer::clear() {
+	oldest = 0;
+	count = 0;
+	frame = 0;
+	needKeyframe = true;
+}
+
+uint64_t RewindBuffer::depth() const {
+	return count ? frame - snapshots[oldest].frame - 1 : 0;
+}
+
+size_t RewindBuffer::memoryUsed() const {
+	size_t used = 0;
+	for (size_t index = 0; index < count; index++)
+		used += snapshots[(oldest + index) % snapshots.size()].size;
+	return used;
+}
@@ -0,0 +1,67 @@
+#ifndef GBPP_SRC_REWINDBUFFER_HPP_
+#define GBPP_SRC_REWINDBUFFER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "defines.hpp"
+#include "gameboy.hpp"
+
+//Rewind history for one GameBoy. A save state is taken every interval frames and kept in a fixed size arena,
+//every keyframeInterval-th one XORed against nothing and the rest against the last of those, then run length
+//coded so the mostly unchanged memory of a delta takes almost no room. The input of every frame is kept too,
+//so rewinding restores the nearest snapshot before the target frame and replays from there. The oldest
+//snapshots are dropped to stay within the depth and memory cap
+class RewindBuffer {
+	struct Snapshot {
+		uint64_t frame; //taken at the start of this frame, before its input was set
+		size_t offset; //into arena
+		size_t size;
+		bool keyframe;
+	};
+
+	uint32_t interval;
+	uint32_t keyframeInterval;
+	std::vector<Byte> arena;
+	//ring of up to depth snapshots, oldest first
+	std::vector<Snapshot> snapshots;
+	size_t oldest = 0;
+	size_t count = 0;
+	uint32_t sinceKeyframe = 0;
+	//the next snapshot can't be a delta, the last keyframe is gone or was never stored
+	bool needKeyframe = true;
+	//one packed Input per frame, by frame number modulo its size
+	std::vector<Byte> inputs;
+	uint64_t frame = 0;
+
+	//state sized scratch buffers
+	size_t stateSize = 0;
+	std::vector<Byte> state;
+	std::vector<Byte> keyframe; //the state the newest snapshots are XORed against
+	std::vector<Byte> encoded;
+
+	Snapshot& snapshot(size_t index);
+	void dropOldest();
+	//room for size bytes in the arena after the newest snapshot, dropping old ones until it fits
+	bool allocate(size_t size, size_t& offset);
+	//decodes a snapshot and the keyframe it's against into state
+	void decode(size_t index);
+
+public:
+	//memoryCap bytes of compressed snapshots, up to depth of them, one every interval frames
+	RewindBuffer(size_t memoryCap, uint32_t depth, uint32_t interval, uint32_t keyframeInterval = 16);
+
+	//call before each runFrame(), with the input that frame runs with
+	void record(const GameBoy& gameboy, const Input& input);
+	//goes back up to frames frames, at most depth(). The framebuffer then shows the frame before the one that
+	//runs next. Returns false if there's no history
+	bool rewind(GameBoy& gameboy, uint64_t frames);
+	//forgets everything, for when the GameBoy was changed some other way
+	void clear();
+
+	//frames that can be gone back
+	uint64_t depth() const;
+	size_t memoryUsed() const;
+};
+
+#endif //GBPP_SRC_REWINDBUFFER_HPP_
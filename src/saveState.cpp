@@ -0,0 +1,174 @@
+#include "gameboy.hpp"
+#include "saveState.hpp"
+
+//Everything that decides how emulation continues. Caches that can be rebuilt from it (decoded tiles, the
+//object index, the palette table, idle loop detection), host side settings (render policy, pixel format) and
+//per call bookkeeping (rendered) aren't part of a state. stateHash() hashes this list too, so anything here
+//has to be the same for two runs that emulate the same
+template <typename Stream, typename Self>
+void GameBoy::transferState(Stream& state, Self& gameboy) {
+	state.field(gameboy.cycles);
+	state.field(gameboy.scheduler);
+	state.field(gameboy.ppuCycles);
+	state.field(gameboy.ppuEnabled);
+	state.field(gameboy.lastRefresh);
+	state.field(gameboy.lastScanline);
+	state.field(gameboy.cyclesToStayInHblank);
+	state.field(gameboy.lastDivUpdate);
+	state.field(gameboy.IME);
+	state.field(gameboy.IME_togge);
+	state.field(gameboy.setIME);
+	state.field(gameboy.AF);
+	state.field(gameboy.BC);
+	state.field(gameboy.DE);
+	state.field(gameboy.HL);
+	state.field(gameboy.SP);
+	state.field(gameboy.PC);
+	state.field(gameboy.currentMode);
+	state.field(gameboy.windowLineCounter);
+	state.field(gameboy.statInteruptLine);
+	state.field(gameboy.prevTMA);
+	state.field(gameboy.lastTIMAUpdate);
+	state.field(gameboy.TIMAFrequency);
+	state.field(gameboy.halted);
+	state.field(gameboy.haltBug);
+	state.field(gameboy.stopped);
+	state.field(gameboy.joypadInput);
+	state.field(gameboy.frameCount);
+#ifdef GBPP_PIXEL_FIFO_PPU
+	state.field(gameboy.fifo);
+#endif
+}
+
+void AddressSpace::saveState(StateWriter& state) const {
+	state.field(bootromLoaded);
+	state.field(mbcController->saveState());
+	state.bytes(memoryLayout.vram, VRAM_SIZE);
+	state.bytes(memoryLayout.memoryBank1, WORK_RAM_BANK_SIZE);
+	state.bytes(memoryLayout.memoryBank2, WORK_RAM_BANK_SIZE);
+	//OAM through IE is one run of bytes
+	const Byte* registers = memoryLayout.oam;
+	state.bytes(registers, &memoryLayout.IE + 1 - registers);
+	for (const auto& bank : cartridgeRamBanks)
+		state.bytes(bank.get(), cartridgeRamBankSize);
+}
+
+void AddressSpace::loadState(StateReader& state) {
+	state.field(bootromLoaded);
+	MBCState mbc;
+	state.field(mbc);
+	mbcController->loadState(mbc);
+	//blocks shared with a fork are replaced rather than written over
+	state.bytes(owned(vramBlock, VRAM_SIZE), VRAM_SIZE);
+	state.bytes(owned(workRamBlocks[0], WORK_RAM_BANK_SIZE), WORK_RAM_BANK_SIZE);
+	state.bytes(owned(workRamBlocks[1], WORK_RAM_BANK_SIZE), WORK_RAM_BANK_SIZE);
+	Byte* registers = memoryLayout.oam;
+	state.bytes(registers, &memoryLayout.IE + 1 - registers);
+	for (auto& bank : cartridgeRamBanks)
+		state.bytes(owned(bank, cartridgeRamBankSize), cartridgeRamBankSize);
+
+	//every page may have changed
+	for (uint32_t& generation : blockGenerations)
+		generation++;
+	for (uint32_t& generation : cartridgeRamGenerations)
+		generation++;
+
+	//the bank pointers follow the restored registers
+	mapBlocks();
+	loadRomBank();
+	loadRamBank();
+	mapMemory();
+}
+
+size_t GameBoy::saveStateSize() const {
+	StateWriter counter;
+	counter.field(SaveStateHeader{});
+	transferState(counter, *this);
+	addressSpace.saveState(counter);
+	return counter.written();
+}
+
+static uint32_t saveStateFlags() {
+#ifdef GBPP_PIXEL_FIFO_PPU
+	return SAVE_STATE_PIXEL_FIFO;
+#else
+	return 0;
+#endif
+}
+
+bool GameBoy::saveState(const std::span<Byte> buffer) const {
+	const size_t size = saveStateSize();
+	if (buffer.size() < size)
+		return false;
+	StateWriter state(buffer.data());
+	state.field(SaveStateHeader{
+		SAVE_STATE_MAGIC, SAVE_STATE_VERSION, static_cast<uint32_t>(size), saveStateFlags(),
+		readOnlyAddressSpace.romHash
+	});
+	transferState(state, *this);
+	addressSpace.saveState(state);
+	return true;
+}
+
+bool GameBoy::loadState(const std::span<const Byte> buffer) {
+	SaveStateHeader header;
+	if (buffer.size() < sizeof(header))
+		return false;
+	std::memcpy(&header, buffer.data(), sizeof(header));
+	//the size also catches a state from a different cartridge RAM size
+	if (header.magic != SAVE_STATE_MAGIC || header.version != SAVE_STATE_VERSION ||
+		header.flags != saveStateFlags() || header.romHash != readOnlyAddressSpace.romHash ||
+		header.size != saveStateSize() || buffer.size() < header.size)
+		return false;
+
+	Byte* oam = addressSpace.memoryLayout.oam;
+	std::array<Byte, sizeof(addressSpace.memoryLayout.oam)> previousOam;
+	std::memcpy(previousOam.data(), oam, previousOam.size());
+
+	StateReader state(buffer.data() + sizeof(header));
+	transferState(state, *this);
+	addressSpace.loadState(state);
+
+	//lines logged before the load belong to a different VRAM, and every row has to be drawn again
+	pendingLines.reset();
+	lineKeysValid.reset();
+	dirtyLines.set();
+	paletteLUTBuilt = false;
+	tileCache.invalidateAll();
+	//restoring states close to each other is common, the object index only follows OAM when it changed
+	const int objectHeight = LCDCBitEnabled(OBJ_SIZE) ? 16 : 8;
+	if (objectHeight != objectIndex.objectHeight())
+		objectIndex.setHeight(oam, objectHeight);
+	else if (std::memcmp(previousOam.data(), oam, previousOam.size()) != 0)
+		objectIndex.rebuild(oam);
+	idleLoop = {};
+	//whether the rest of this frame is drawn is up to this instance's policy, not the one that saved it. A
+	//pending request is only used up once a frame starts, so loading any number of states keeps it
+	renderingFrame = wouldRenderFrame();
+	return true;
+}
+
+std::unique_ptr<GameBoy> GameBoy::fork() {
+	auto child = std::make_unique<GameBoy>();
+	//the same fields a save state has, without the memory
+	StateWriter counter;
+	transferState(counter, *this);
+	std::vector<Byte> fields(counter.written());
+	StateWriter writer(fields.data());
+	transferState(writer, *this);
+	StateReader reader(fields.data());
+	transferState(reader, *child);
+	child->addressSpace.fork(addressSpace);
+
+	child->renderPolicy = renderPolicy;
+	child->renderInterval = renderInterval;
+	child->renderRequested = renderRequested;
+	child->renderingFrame = renderingFrame;
+	child->lastFrameDrawn = lastFrameDrawn;
+	child->setPixelFormat(pixelFormat);
+	//pending lines are drawn from the VRAM and OAM both now share
+	child->lineStates = lineStates;
+	child->pendingLines = pendingLines;
+	child->objectIndex = objectIndex;
+	return child;
+}
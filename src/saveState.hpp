@@ -0,0 +1,72 @@
+#ifndef GBPP_SRC_SAVESTATE_HPP_
+#define GBPP_SRC_SAVESTATE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "defines.hpp"
+
+#define SAVE_STATE_MAGIC 0x53504247 //"GBPS"
+//bump whenever a field is added, removed or reordered
+#define SAVE_STATE_VERSION 5
+//states from a pixel FIFO build carry its mode 3 state and can't be loaded by the other backend
+#define SAVE_STATE_PIXEL_FIFO 0x01
+
+struct SaveStateHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t size; //whole state including this header
+	uint32_t flags;
+	uint64_t romHash; //the ROM isn't stored, only checked against the one loaded
+};
+
+//A state is written and read front to back with the same list of fields, each one memcpy'd in its native
+//layout. States are for the build that wrote them, not for exchanging between machines. Fields can't have
+//padding, so equal states are equal bytes and hash the same.
+//A writer without a buffer only counts the bytes
+class StateWriter {
+	Byte* out;
+	size_t size = 0;
+
+public:
+	explicit StateWriter(Byte* out = nullptr) : out(out) {
+	}
+
+	void bytes(const void* data, const size_t count) {
+		if (out)
+			std::memcpy(out + size, data, count);
+		size += count;
+	}
+
+	template <typename T>
+	void field(const T& value) {
+		static_assert(std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>);
+		bytes(&value, sizeof(T));
+	}
+
+	size_t written() const {
+		return size;
+	}
+};
+
+class StateReader {
+	const Byte* in;
+
+public:
+	explicit StateReader(const Byte* in) : in(in) {
+	}
+
+	void bytes(void* data, const size_t count) {
+		std::memcpy(data, in, count);
+		in += count;
+	}
+
+	template <typename T>
+	void field(T& value) {
+		static_assert(std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>);
+		bytes(&value, sizeof(T));
+	}
+};
+
+#endif //GBPP_SRC_SAVESTATE_HPP_
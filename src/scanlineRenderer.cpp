@@ -0,0 +1,229 @@
+#include "scanlineRenderer.hpp"
+#include <cstring>
+#include <utility>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define GBPP_X86_SIMD
+#include <immintrin.h>
+#endif
+
+int scanlineBytes(const PixelFormat format) {
+	switch (format) {
+	case pixelARGB8888:
+		return RESOLUTION_X * 4;
+	case pixelRGB565:
+		return RESOLUTION_X * 2;
+	case pixelGray8:
+	case pixelShade8:
+		return RESOLUTION_X;
+	case pixelShade2:
+		return RESOLUTION_X / 4;
+	default:
+		std::unreachable();
+	}
+}
+
+uint32_t shadeToPixel(const Byte shade, const PixelFormat format) {
+	static constexpr Byte grays[4] = {0xFF, 0xAA, 0x55, 0x00};
+	const Byte gray = grays[shade & 0x3];
+	switch (format) {
+	case pixelARGB8888:
+		return 0xFF000000 | gray << 16 | gray << 8 | gray;
+	case pixelRGB565:
+		return (gray >> 3) << 11 | (gray >> 2) << 5 | gray >> 3;
+	case pixelGray8:
+		return gray;
+	case pixelShade8:
+	case pixelShade2:
+		return shade & 0x3;
+	default:
+		std::unreachable();
+	}
+}
+
+//an object pixel loses to any BG colour but 0 when its BG over OBJ flag is set
+static Byte paletteIndex(const Byte bg, const Byte obj) {
+	const bool objVisible = (obj & 0x03) && !((obj & OBJ_LINE_BG_OVER_OBJ) && bg);
+	return objVisible ? 4 + (obj & 0x07) : bg;
+}
+
+void composeScanlineScalar(const Byte* bg, const Byte* obj, const uint32_t* palette, const PixelFormat format,
+                           Byte* out) {
+	switch (format) {
+	case pixelARGB8888:
+		for (int i = 0; i < RESOLUTION_X; i++) {
+			const uint32_t pixel = palette[paletteIndex(bg[i], obj[i])];
+			std::memcpy(out + i * 4, &pixel, 4);
+		}
+		break;
+	case pixelRGB565:
+		for (int i = 0; i < RESOLUTION_X; i++) {
+			const uint16_t pixel = palette[paletteIndex(bg[i], obj[i])];
+			std::memcpy(out + i * 2, &pixel, 2);
+		}
+		break;
+	case pixelGray8:
+	case pixelShade8:
+		for (int i = 0; i < RESOLUTION_X; i++)
+			out[i] = palette[paletteIndex(bg[i], obj[i])];
+		break;
+	case pixelShade2:
+		for (int i = 0; i < RESOLUTION_X; i += 4) {
+			out[i / 4] = palette[paletteIndex(bg[i], obj[i])] << 6 | palette[paletteIndex(bg[i + 1], obj[i + 1])] << 4 |
+				palette[paletteIndex(bg[i + 2], obj[i + 2])] << 2 | palette[paletteIndex(bg[i + 3], obj[i + 3])];
+		}
+		break;
+	}
+}
+
+#ifdef GBPP_X86_SIMD
+//The palette split into 4 byte planes so pshufb can look each one up
+struct PalettePlanes {
+	__m128i bytes[4];
+};
+
+__attribute__((target("ssse3")))
+static PalettePlanes splitPalette(const uint32_t* palette) {
+	alignas(16) Byte planeBytes[4][16];
+	for (int entry = 0; entry < 16; entry++) {
+		for (int plane = 0; plane < 4; plane++)
+			planeBytes[plane][entry] = palette[entry] >> (plane * 8);
+	}
+	PalettePlanes planes;
+	for (int plane = 0; plane < 4; plane++)
+		planes.bytes[plane] = _mm_load_si128(reinterpret_cast<const __m128i*>(planeBytes[plane]));
+	return planes;
+}
+
+//16 palette indices to pixels at pixel x of the line, wider pixels are put back together from the looked up
+//planes
+__attribute__((target("ssse3")))
+static inline void expandPixels(const __m128i index, const PalettePlanes& planes, const PixelFormat format, Byte* out,
+                                const int x) {
+	const __m128i byte0 = _mm_shuffle_epi8(planes.bytes[0], index);
+	switch (format) {
+	case pixelARGB8888: {
+		const __m128i byte1 = _mm_shuffle_epi8(planes.bytes[1], index);
+		const __m128i byte2 = _mm_shuffle_epi8(planes.bytes[2], index);
+		const __m128i byte3 = _mm_shuffle_epi8(planes.bytes[3], index);
+		const __m128i low01 = _mm_unpacklo_epi8(byte0, byte1);
+		const __m128i high01 = _mm_unpackhi_epi8(byte0, byte1);
+		const __m128i low23 = _mm_unpacklo_epi8(byte2, byte3);
+		const __m128i high23 = _mm_unpackhi_epi8(byte2, byte3);
+		__m128i* pixels = reinterpret_cast<__m128i*>(out + x * 4);
+		_mm_storeu_si128(pixels, _mm_unpacklo_epi16(low01, low23));
+		_mm_storeu_si128(pixels + 1, _mm_unpackhi_epi16(low01, low23));
+		_mm_storeu_si128(pixels + 2, _mm_unpacklo_epi16(high01, high23));
+		_mm_storeu_si128(pixels + 3, _mm_unpackhi_epi16(high01, high23));
+		break;
+	}
+	case pixelRGB565: {
+		const __m128i byte1 = _mm_shuffle_epi8(planes.bytes[1], index);
+		__m128i* pixels = reinterpret_cast<__m128i*>(out + x * 2);
+		_mm_storeu_si128(pixels, _mm_unpacklo_epi8(byte0, byte1));
+		_mm_storeu_si128(pixels + 1, _mm_unpackhi_epi8(byte0, byte1));
+		break;
+	}
+	case pixelGray8:
+	case pixelShade8:
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), byte0);
+		break;
+	case pixelShade2: {
+		//pairs of shades into nibbles, then pairs of nibbles into bytes
+		const __m128i pairs = _mm_maddubs_epi16(byte0, _mm_set1_epi16(0x0104));
+		const __m128i nibbles = _mm_packus_epi16(pairs, pairs);
+		const __m128i quads = _mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x0110));
+		const int packed = _mm_cvtsi128_si32(_mm_packus_epi16(quads, quads));
+		std::memcpy(out + x / 4, &packed, 4);
+		break;
+	}
+	}
+}
+
+//16 pixels a time
+__attribute__((target("ssse3")))
+static void composeScanlineSSSE3(const Byte* bg, const Byte* obj, const uint32_t* palette, const PixelFormat format,
+                                 Byte* out) {
+	const PalettePlanes planes = splitPalette(palette);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i colourMask = _mm_set1_epi8(0x03);
+	const __m128i paletteMask = _mm_set1_epi8(0x07);
+	const __m128i objOffset = _mm_set1_epi8(4);
+	const __m128i bgOverObj = _mm_set1_epi8(static_cast<char>(OBJ_LINE_BG_OVER_OBJ));
+
+	for (int i = 0; i < RESOLUTION_X; i += 16) {
+		const __m128i bgIndex = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bg + i));
+		const __m128i objPixel = _mm_loadu_si128(reinterpret_cast<const __m128i*>(obj + i));
+
+		const __m128i objTransparent = _mm_cmpeq_epi8(_mm_and_si128(objPixel, colourMask), zero);
+		const __m128i bgOpaque = _mm_andnot_si128(_mm_cmpeq_epi8(bgIndex, zero), _mm_set1_epi8(-1));
+		const __m128i objBehind = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(objPixel, bgOverObj), bgOverObj), bgOpaque);
+		const __m128i showBg = _mm_or_si128(objTransparent, objBehind);
+		const __m128i objIndex = _mm_add_epi8(_mm_and_si128(objPixel, paletteMask), objOffset);
+		const __m128i index = _mm_or_si128(_mm_and_si128(showBg, bgIndex), _mm_andnot_si128(showBg, objIndex));
+
+		expandPixels(index, planes, format, out, i);
+	}
+}
+
+//32 pixels a time for the masks. ARGB8888 comes straight from the palette 8 pixels a time with permutevar8x32,
+//narrower formats use the pshufb planes on each half
+__attribute__((target("avx2")))
+static void composeScanlineAVX2(const Byte* bg, const Byte* obj, const uint32_t* palette, const PixelFormat format,
+                                Byte* out) {
+	const __m256i paletteLow = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(palette));
+	const __m256i paletteHigh = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(palette + 8));
+	const __m256i seven = _mm256_set1_epi32(7);
+	const PalettePlanes planes = splitPalette(palette);
+
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i colourMask = _mm256_set1_epi8(0x03);
+	const __m256i paletteMask = _mm256_set1_epi8(0x07);
+	const __m256i objOffset = _mm256_set1_epi8(4);
+	const __m256i bgOverObj = _mm256_set1_epi8(static_cast<char>(OBJ_LINE_BG_OVER_OBJ));
+
+	for (int i = 0; i < RESOLUTION_X; i += 32) {
+		const __m256i bgIndex = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bg + i));
+		const __m256i objPixel = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(obj + i));
+
+		const __m256i objTransparent = _mm256_cmpeq_epi8(_mm256_and_si256(objPixel, colourMask), zero);
+		const __m256i bgOpaque = _mm256_andnot_si256(_mm256_cmpeq_epi8(bgIndex, zero), _mm256_set1_epi8(-1));
+		const __m256i objBehind = _mm256_and_si256(
+			_mm256_cmpeq_epi8(_mm256_and_si256(objPixel, bgOverObj), bgOverObj), bgOpaque);
+		const __m256i showBg = _mm256_or_si256(objTransparent, objBehind);
+		const __m256i objIndex = _mm256_add_epi8(_mm256_and_si256(objPixel, paletteMask), objOffset);
+		const __m256i index = _mm256_blendv_epi8(objIndex, bgIndex, showBg);
+
+		const __m128i halves[2] = {_mm256_castsi256_si128(index), _mm256_extracti128_si256(index, 1)};
+		for (int half = 0; half < 2; half++) {
+			if (format != pixelARGB8888) {
+				expandPixels(halves[half], planes, format, out, i + half * 16);
+				continue;
+			}
+			for (int quarter = 0; quarter < 2; quarter++) {
+				const __m256i entry = _mm256_cvtepu8_epi32(quarter ? _mm_srli_si128(halves[half], 8) : halves[half]);
+				const __m256i colour = _mm256_blendv_epi8(_mm256_permutevar8x32_epi32(paletteLow, entry),
+				                                          _mm256_permutevar8x32_epi32(paletteHigh, entry),
+				                                          _mm256_cmpgt_epi32(entry, seven));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + (i + half * 16 + quarter * 8) * 4), colour);
+			}
+		}
+	}
+}
+#endif
+
+std::vector<NamedComposer> supportedScanlineComposers() {
+	std::vector<NamedComposer> composers = {{"scalar", composeScanlineScalar}};
+#ifdef GBPP_X86_SIMD
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("ssse3"))
+		composers.push_back({"SSSE3", composeScanlineSSSE3});
+	if (__builtin_cpu_supports("avx2"))
+		composers.push_back({"AVX2", composeScanlineAVX2});
+#endif
+	return composers;
+}
+
+ScanlineComposer selectScanlineComposer() {
+	return supportedScanlineComposers().back().compose;
+}
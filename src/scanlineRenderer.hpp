@@ -0,0 +1,33 @@
+#ifndef GBPP_SRC_SCANLINERENDERER_HPP_
+#define GBPP_SRC_SCANLINERENDERER_HPP_
+
+#include <cstdint>
+#include <vector>
+#include "defines.hpp"
+
+#define OBJ_LINE_PALETTE 0x04 //OBP1 rather than OBP0
+#define OBJ_LINE_BG_OVER_OBJ 0x80
+
+//Turns one line of colour indices into output pixels. bg holds BG/window colour indices (0-3), obj holds the
+//winning object pixel as colour index (0 = none) | OBJ_LINE_PALETTE | OBJ_LINE_BG_OVER_OBJ. palette has 16
+//entries already in the output format, 0-3 for BGP, 4-7 for OBP0 and 8-11 for OBP1. bg and obj are RESOLUTION_X
+//long, out gets scanlineBytes(format)
+using ScanlineComposer = void (*)(const Byte* bg, const Byte* obj, const uint32_t* palette, PixelFormat format,
+                                  Byte* out);
+
+struct NamedComposer {
+	const char* name;
+	ScanlineComposer compose;
+};
+
+void composeScanlineScalar(const Byte* bg, const Byte* obj, const uint32_t* palette, PixelFormat format, Byte* out);
+//every version the host CPU supports, narrowest first, so they can be checked against each other
+std::vector<NamedComposer> supportedScanlineComposers();
+//the widest version the host CPU supports: AVX2, SSSE3 or the scalar fallback
+ScanlineComposer selectScanlineComposer();
+
+int scanlineBytes(PixelFormat format);
+//a palette shade (0 white to 3 black) as a pixel of the format
+uint32_t shadeToPixel(Byte shade, PixelFormat format);
+
+#endif //GBPP_SRC_SCANLINERENDERER_HPP_
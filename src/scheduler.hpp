@@ -0,0 +1,49 @@
+#ifndef GBPP_SRC_SCHEDULER_HPP_
+#define GBPP_SRC_SCHEDULER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+enum SchedulerEvent {
+	timerEvent, //TIMA overflow
+	ppuEvent, //PPU mode change, or a STAT/LYC write that needs the STAT line re-evaluating
+	dmaEvent, //OAM DMA completion
+	interruptEvent, //an interrupt that can be taken or end a HALT, or EI taking effect
+	stopEvent, //end of a runFrame()/runCycles() slice
+	eventCount
+};
+
+//One slot per event type, keyed on the T-cycle counter. The CPU runs instructions back to back until
+//nextEvent() instead of polling the timer, PPU, DMA and interrupts after every instruction
+class Scheduler {
+	std::array<uint64_t, eventCount> events;
+	uint64_t next = never;
+
+public:
+	static constexpr uint64_t never = UINT64_MAX;
+
+	Scheduler() {
+		events.fill(never);
+	}
+
+	//replaces any previous time for this event, a time in the past fires at the next instruction boundary
+	void schedule(const SchedulerEvent event, const uint64_t cycle) {
+		events[event] = cycle;
+		next = *std::ranges::min_element(events);
+	}
+
+	void cancel(const SchedulerEvent event) {
+		schedule(event, never);
+	}
+
+	bool due(const SchedulerEvent event, const uint64_t cycle) const {
+		return events[event] <= cycle;
+	}
+
+	uint64_t nextEvent() const {
+		return next;
+	}
+};
+
+#endif //GBPP_SRC_SCHEDULER_HPP_
@@ -0,0 +1,205 @@
+#include "sdlFrontend.hpp"
+#include <functional>
+#include <thread>
+
+void SDLFrontend::SDL2setup() {
+	SDL_Init(SDL_INIT_EVERYTHING);
+	screen = SDL_CreateWindow("GameBoy++",
+	                          SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+	                          RESOLUTION_X, RESOLUTION_Y,
+	                          0);
+
+	// Create an SDL renderer to draw on the window
+	//vsync only holds up presentation, the emulation thread is paced separately
+	renderer = SDL_CreateRenderer(screen, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+
+	// Create an SDL texture to hold the framebuffer data
+	texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+	                            SDL_TEXTUREACCESS_STREAMING, RESOLUTION_X, RESOLUTION_Y);
+}
+
+void SDLFrontend::SDL2destroy() const {
+	SDL_DestroyTexture(texture);
+	SDL_DestroyRenderer(renderer);
+	SDL_DestroyWindow(screen);
+	SDL_Quit();
+}
+
+void SDLFrontend::SDL2present(const PresentedFrame& frame) {
+	//the core's default ARGB8888, same as the texture
+	const int pitch = scanlineBytes(pixelARGB8888);
+	if (frame.sequence != presentedSequence + 1) {
+		SDL_UpdateTexture(texture, nullptr, frame.pixels.data(), pitch);
+	}
+	else {
+		for (const LineSpan span : lineSpans(frame.dirtyLines)) {
+			const SDL_Rect rows = {0, span.first, RESOLUTION_X, span.count};
+			SDL_UpdateTexture(texture, &rows, frame.pixels.data() + span.first * pitch, pitch);
+		}
+	}
+	presentedSequence = frame.sequence;
+	SDL_RenderClear(renderer);
+	SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+	SDL_RenderPresent(renderer);
+}
+
+void SDLFrontend::publishFrame(GameBoy& gameboy) {
+	PresentedFrame& frame = frames.back();
+	const std::span<const Byte> framebuffer = gameboy.getFramebuffer();
+	frame.pixels.assign(framebuffer.begin(), framebuffer.end());
+	frame.dirtyLines = gameboy.takeDirtyLines();
+	frame.sequence = ++publishedSequence;
+	frames.publish();
+}
+
+void SDLFrontend::emulate(GameBoy& gameboy) {
+	while (!quit) {
+		switch (const int speed = requestedSpeed.exchange(-1)) {
+		case -1:
+			break;
+		case 0:
+			pacer.setMode(unthrottledPacing);
+			break;
+		case 1:
+			pacer.setMode(realTimePacing);
+			break;
+		default:
+			pacer.setMode(multipliedPacing, speed);
+			break;
+		}
+
+		if (!debug) {
+			if (rewinding) {
+				if (rewindBuffer.rewind(gameboy, 1))
+					publishFrame(gameboy);
+			}
+			else {
+				const Input input = sharedInput.load();
+				rewindBuffer.record(gameboy, input);
+				gameboy.setInput(input);
+				gameboy.runFrame();
+				publishFrame(gameboy);
+			}
+			pacer.wait();
+		}
+		else if (step.exchange(false)) {
+			//stepping leaves the GameBoy between frames, which the history can't replay from
+			rewindBuffer.clear();
+			gameboy.setInput(sharedInput.load());
+			gameboy.printState();
+			if (gameboy.step())
+				publishFrame(gameboy);
+		}
+		else {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+}
+
+void SDLFrontend::run(GameBoy& gameboy) {
+	std::thread emulation(&SDLFrontend::emulate, this, std::ref(gameboy));
+
+	while (!quit) {
+		// Event loop
+		while (SDL_PollEvent(&event)) {
+			switch (event.type) {
+			case SDL_QUIT:
+				quit = true;
+				break;
+			case SDL_KEYDOWN:
+				switch (event.key.keysym.sym) {
+				case SDLK_a:
+					joypadInput.LEFT = true;
+					break;
+				case SDLK_d:
+					joypadInput.RIGHT = true;
+					break;
+				case SDLK_w:
+					joypadInput.UP = true;
+					break;
+				case SDLK_s:
+					joypadInput.DOWN = true;
+					break;
+				case SDLK_k:
+					joypadInput.A = true;
+					break;
+				case SDLK_l:
+					joypadInput.B = true;
+					break;
+				case SDLK_o:
+					joypadInput.SELECT = true;
+					break;
+				case SDLK_p:
+					joypadInput.START = true;
+					break;
+				case SDLK_h:
+					debug = !debug;
+					break;
+				case SDLK_n:
+					step = true;
+					break;
+				case SDLK_BACKSPACE:
+					rewinding = true;
+					break;
+				case SDLK_0:
+				case SDLK_1:
+				case SDLK_2:
+				case SDLK_3:
+				case SDLK_4:
+				case SDLK_5:
+				case SDLK_6:
+				case SDLK_7:
+				case SDLK_8:
+				case SDLK_9:
+					requestedSpeed = event.key.keysym.sym - SDLK_0;
+					break;
+				default:
+					break;
+				}
+				break;
+			case SDL_KEYUP:
+				switch (event.key.keysym.sym) {
+				case SDLK_a:
+					joypadInput.LEFT = false;
+					break;
+				case SDLK_d:
+					joypadInput.RIGHT = false;
+					break;
+				case SDLK_w:
+					joypadInput.UP = false;
+					break;
+				case SDLK_s:
+					joypadInput.DOWN = false;
+					break;
+				case SDLK_k:
+					joypadInput.A = false;
+					break;
+				case SDLK_l:
+					joypadInput.B = false;
+					break;
+				case SDLK_o:
+					joypadInput.SELECT = false;
+					break;
+				case SDLK_p:
+					joypadInput.START = false;
+					break;
+				case SDLK_BACKSPACE:
+					rewinding = false;
+					break;
+				default:
+					break;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		sharedInput = joypadInput;
+
+		if (frames.acquire())
+			SDL2present(frames.front());
+		else
+			SDL_Delay(1);
+	}
+	emulation.join();
+}
@@ -0,0 +1,63 @@
+#ifndef GBPP_SRC_SDLFRONTEND_HPP_
+#define GBPP_SRC_SDLFRONTEND_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <SDL.h>
+#include "defines.hpp"
+#include "framePacer.hpp"
+#include "gameboy.hpp"
+#include "rewindBuffer.hpp"
+#include "scanlineRenderer.hpp"
+#include "tripleBuffer.hpp"
+
+//a finished frame on its way from the emulation thread to the window
+struct PresentedFrame {
+	std::vector<Byte> pixels;
+	LineMask dirtyLines;
+	//counts up from 1, a gap means frames were dropped and their dirty rows with them
+	uint64_t sequence = 0;
+};
+
+//Window, input and frame pacing on top of the headless core. The core runs and is paced on its own thread and
+//hands finished frames over through a triple buffer, so it never waits on the GPU driver, vsync or the window
+//system. Events and presentation stay on the thread that called run(), as SDL wants
+class SDLFrontend {
+	SDL_Window* screen = nullptr;
+	SDL_Renderer* renderer = nullptr;
+	SDL_Texture* texture = nullptr;
+	SDL_Event event = {0};
+
+	TripleBuffer<PresentedFrame> frames;
+	uint64_t presentedSequence = 0;
+
+	//set by the event loop, read by the emulation thread
+	Input joypadInput;
+	std::atomic<Input> sharedInput;
+	std::atomic<bool> quit = false;
+	std::atomic<bool> debug = false;
+	std::atomic<bool> step = false;
+	//held down to run backwards a frame at a time
+	std::atomic<bool> rewinding = false;
+	//0 for unthrottled, 1 for real time, 2-9 for that multiple of it, -1 once taken
+	std::atomic<int> requestedSpeed = -1;
+
+	//emulation thread only
+	FramePacer pacer;
+	//4 MB of history, a snapshot every 8 frames
+	RewindBuffer rewindBuffer{4 << 20, 4096, 8};
+	uint64_t publishedSequence = 0;
+
+	void emulate(GameBoy& gameboy);
+	void publishFrame(GameBoy& gameboy);
+	//only the rows dirty since the last presented frame are uploaded to the texture
+	void SDL2present(const PresentedFrame& frame);
+
+public:
+	void SDL2setup();
+	void SDL2destroy() const;
+	void run(GameBoy& gameboy);
+};
+
+#endif //GBPP_SRC_SDLFRONTEND_HPP_
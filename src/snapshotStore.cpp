@@ -0,0 +1,292 @@
+#include "snapshotStore.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include "stateHash.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SNAPSHOT_STORE_SPILL
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+//pages per resident chunk
+#define RESIDENT_CHUNK 4096
+//the spill file grows by at least this many pages at a time
+#define SPILL_GROWTH 4096
+
+SnapshotStore::SnapshotStore(const size_t residentBytes, const std::string& spillPath) :
+	residentCap(std::max<size_t>(residentBytes / SNAPSHOT_PAGE_SIZE, 1)) {
+#ifdef SNAPSHOT_STORE_SPILL
+	if (!spillPath.empty()) {
+		spillFile = open(spillPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+		if (spillFile < 0)
+			std::cerr << "Snapshot spill file couldn't be opened, keeping every page in memory" << std::endl;
+		else
+			unlink(spillPath.c_str()); //only lives as long as the store
+	}
+#endif
+}
+
+SnapshotStore::~SnapshotStore() {
+#ifdef SNAPSHOT_STORE_SPILL
+	if (spillMap)
+		munmap(spillMap, spillSlots * SNAPSHOT_PAGE_SIZE);
+	if (spillFile >= 0)
+		close(spillFile);
+#endif
+}
+
+Byte* SnapshotStore::residentPage(const uint32_t slot) const {
+	return residentChunks[slot / RESIDENT_CHUNK].get() + slot % RESIDENT_CHUNK * SNAPSHOT_PAGE_SIZE;
+}
+
+const Byte* SnapshotStore::pageData(const uint32_t id) {
+	Page& page = pages[id];
+	page.accessed = true;
+	if (page.spilled)
+		return spillMap + static_cast<size_t>(page.slot) * SNAPSHOT_PAGE_SIZE;
+	return residentPage(page.slot);
+}
+
+uint32_t SnapshotStore::intern(const Byte* data, const bool index, bool& created) {
+	//index pages are hashed apart from data pages
+	const uint64_t hash = hashBytes(data, SNAPSHOT_PAGE_SIZE, index).low;
+	const auto found = pageByHash.find(hash);
+	if (found != pageByHash.end() && pages[found->second].index == index &&
+		std::memcmp(pageData(found->second), data, SNAPSHOT_PAGE_SIZE) == 0) {
+		pages[found->second].references++;
+		created = false;
+		return found->second;
+	}
+
+	const uint32_t slot = residentSlot();
+	uint32_t id;
+	if (!freePages.empty()) {
+		id = freePages.back();
+		freePages.pop_back();
+	}
+	else {
+		id = pages.size();
+		pages.emplace_back();
+	}
+	pages[id] = {hash, 1, slot, false, true, index};
+	residentOwner[slot] = id;
+	std::memcpy(residentPage(slot), data, SNAPSHOT_PAGE_SIZE);
+	if (found == pageByHash.end())
+		pageByHash.emplace(hash, id);
+	created = true;
+	return id;
+}
+
+void SnapshotStore::releasePage(const uint32_t id, const uint8_t level) {
+	if (--pages[id].references)
+		return;
+	if (level) {
+		uint32_t ids[SNAPSHOT_PAGE_IDS];
+		std::memcpy(ids, pageData(id), SNAPSHOT_PAGE_SIZE);
+		for (const uint32_t child : ids) {
+			if (child != SNAPSHOT_NO_PAGE)
+				releasePage(child, level - 1);
+		}
+	}
+
+	const Page& page = pages[id];
+	if (page.spilled)
+		freeSpilled.push_back(page.slot);
+	else
+		freeResident.push_back(page.slot);
+	const auto found = pageByHash.find(page.hash);
+	if (found != pageByHash.end() && found->second == id)
+		pageByHash.erase(found);
+	freePages.push_back(id);
+}
+
+uint32_t SnapshotStore::residentSlot() {
+	if (freeResident.empty() && !(residentOwner.size() >= residentCap && spillFile >= 0 && evict())) {
+		//under the cap or nowhere to spill to
+		if (residentOwner.size() % RESIDENT_CHUNK == 0)
+			residentChunks.push_back(std::make_unique_for_overwrite<Byte[]>(RESIDENT_CHUNK * SNAPSHOT_PAGE_SIZE));
+		residentOwner.push_back(0);
+		return residentOwner.size() - 1;
+	}
+	const uint32_t slot = freeResident.back();
+	freeResident.pop_back();
+	return slot;
+}
+
+bool SnapshotStore::evict() {
+	//second chance, pages read since the hand last passed are skipped once
+	const size_t slots = residentOwner.size();
+	for (size_t steps = 0; steps < 2 * slots; steps++) {
+		const uint32_t slot = clockHand;
+		clockHand = (clockHand + 1) % slots;
+		Page& page = pages[residentOwner[slot]];
+		if (page.accessed) {
+			page.accessed = false;
+			continue;
+		}
+		const uint32_t target = spillSlot();
+		if (target == SNAPSHOT_NO_PAGE)
+			return false;
+		std::memcpy(spillMap + static_cast<size_t>(target) * SNAPSHOT_PAGE_SIZE, residentPage(slot), SNAPSHOT_PAGE_SIZE);
+		page.spilled = true;
+		page.slot = target;
+		freeResident.push_back(slot);
+		return true;
+	}
+	return false;
+}
+
+uint32_t SnapshotStore::spillSlot() {
+	if (!freeSpilled.empty()) {
+		const uint32_t slot = freeSpilled.back();
+		freeSpilled.pop_back();
+		return slot;
+	}
+#ifdef SNAPSHOT_STORE_SPILL
+	//every slot below spillSlots is either free or taken, so a full file has no free ones left
+	const size_t used = spillSlots;
+	const size_t grown = std::max<size_t>(spillSlots * 2, SPILL_GROWTH);
+	if (ftruncate(spillFile, grown * SNAPSHOT_PAGE_SIZE) != 0)
+		return SNAPSHOT_NO_PAGE;
+	void* map = mmap(nullptr, grown * SNAPSHOT_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, spillFile, 0);
+	if (map == MAP_FAILED)
+		return SNAPSHOT_NO_PAGE;
+	if (spillMap)
+		munmap(spillMap, spillSlots * SNAPSHOT_PAGE_SIZE);
+	spillMap = static_cast<Byte*>(map);
+	spillSlots = grown;
+	for (size_t slot = grown - 1; slot > used; slot--)
+		freeSpilled.push_back(slot);
+	return used;
+#else
+	return SNAPSHOT_NO_PAGE;
+#endif
+}
+
+SnapshotStore::Handle SnapshotStore::put(const std::span<const Byte> state) {
+	levelIds.clear();
+	for (size_t offset = 0; offset < state.size(); offset += SNAPSHOT_PAGE_SIZE) {
+		const size_t length = std::min<size_t>(SNAPSHOT_PAGE_SIZE, state.size() - offset);
+		const Byte* data = state.data() + offset;
+		Byte padded[SNAPSHOT_PAGE_SIZE] = {};
+		if (length < SNAPSHOT_PAGE_SIZE) {
+			std::memcpy(padded, data, length);
+			data = padded;
+		}
+		bool created;
+		levelIds.push_back(intern(data, false, created));
+	}
+
+	uint8_t levels = 0;
+	while (levelIds.size() > SNAPSHOT_ROOT_IDS) {
+		aboveIds.clear();
+		for (size_t first = 0; first < levelIds.size(); first += SNAPSHOT_PAGE_IDS) {
+			uint32_t ids[SNAPSHOT_PAGE_IDS];
+			std::fill_n(ids, SNAPSHOT_PAGE_IDS, SNAPSHOT_NO_PAGE);
+			const size_t count = std::min<size_t>(SNAPSHOT_PAGE_IDS, levelIds.size() - first);
+			std::copy_n(levelIds.begin() + first, count, ids);
+			bool created;
+			aboveIds.push_back(intern(reinterpret_cast<const Byte*>(ids), true, created));
+			//an index page that was already stored holds its own references to the pages under it
+			if (!created) {
+				for (size_t child = 0; child < count; child++)
+					pages[ids[child]].references--;
+			}
+		}
+		levelIds.swap(aboveIds);
+		levels++;
+	}
+
+	State stored = {static_cast<uint32_t>(state.size()), levels, static_cast<uint8_t>(levelIds.size()), {}};
+	std::ranges::copy(levelIds, stored.roots);
+	if (!freeStates.empty()) {
+		const Handle handle = freeStates.back();
+		freeStates.pop_back();
+		states[handle] = stored;
+		return handle;
+	}
+	states.push_back(stored);
+	return states.size() - 1;
+}
+
+SnapshotStore::Handle SnapshotStore::put(const GameBoy& gameboy) {
+	stateBuffer.resize(gameboy.saveStateSize());
+	gameboy.saveState(stateBuffer);
+	return put(stateBuffer);
+}
+
+void SnapshotStore::expand(const uint32_t id, const uint8_t level, Byte*& out, size_t& remaining) {
+	if (level == 0) {
+		const size_t length = std::min<size_t>(SNAPSHOT_PAGE_SIZE, remaining);
+		std::memcpy(out, pageData(id), length);
+		out += length;
+		remaining -= length;
+		return;
+	}
+	uint32_t ids[SNAPSHOT_PAGE_IDS];
+	std::memcpy(ids, pageData(id), SNAPSHOT_PAGE_SIZE);
+	for (const uint32_t child : ids) {
+		if (child != SNAPSHOT_NO_PAGE)
+			expand(child, level - 1, out, remaining);
+	}
+}
+
+bool SnapshotStore::get(const Handle handle, const std::span<Byte> buffer) {
+	if (handle >= states.size() || states[handle].size == 0 || buffer.size() < states[handle].size)
+		return false;
+	const State& state = states[handle];
+	Byte* out = buffer.data();
+	size_t remaining = state.size;
+	for (uint8_t root = 0; root < state.rootCount; root++)
+		expand(state.roots[root], state.levels, out, remaining);
+	return true;
+}
+
+bool SnapshotStore::load(const Handle handle, GameBoy& gameboy) {
+	stateBuffer.resize(size(handle));
+	return get(handle, stateBuffer) && gameboy.loadState(stateBuffer);
+}
+
+void SnapshotStore::release(const Handle handle) {
+	if (handle >= states.size() || states[handle].size == 0)
+		return;
+	State& state = states[handle];
+	for (uint8_t root = 0; root < state.rootCount; root++)
+		releasePage(state.roots[root], state.levels);
+	state.size = 0;
+	freeStates.push_back(handle);
+}
+
+size_t SnapshotStore::size(const Handle handle) const {
+	return handle < states.size() ? states[handle].size : 0;
+}
+
+size_t SnapshotStore::storedStates() const {
+	return states.size() - freeStates.size();
+}
+
+size_t SnapshotStore::uniquePages() const {
+	return pages.size() - freePages.size();
+}
+
+size_t SnapshotStore::residentBytes() const {
+	return (residentOwner.size() - freeResident.size()) * SNAPSHOT_PAGE_SIZE;
+}
+
+size_t SnapshotStore::spilledBytes() const {
+	return (spillSlots - freeSpilled.size()) * SNAPSHOT_PAGE_SIZE;
+}
+
+size_t SnapshotStore::memoryUsed() const {
+	//a hash map node is about its value and a next pointer, plus a bucket pointer
+	const size_t hashMap = pageByHash.size() * (sizeof(std::pair<uint64_t, uint32_t>) + sizeof(void*)) +
+		pageByHash.bucket_count() * sizeof(void*);
+	return residentChunks.size() * RESIDENT_CHUNK * SNAPSHOT_PAGE_SIZE +
+		residentOwner.capacity() * sizeof(uint32_t) +
+		pages.capacity() * sizeof(Page) +
+		states.capacity() * sizeof(State) +
+		hashMap;
+}
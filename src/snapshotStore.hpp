@@ -0,0 +1,107 @@
+#ifndef GBPP_SRC_SNAPSHOTSTORE_HPP_
+#define GBPP_SRC_SNAPSHOTSTORE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "defines.hpp"
+#include "gameboy.hpp"
+
+#define SNAPSHOT_PAGE_SIZE 256
+//page ids in an index page
+#define SNAPSHOT_PAGE_IDS (SNAPSHOT_PAGE_SIZE / sizeof(uint32_t))
+//page ids a state holds itself, index levels are added until its top level fits
+#define SNAPSHOT_ROOT_IDS 4
+//pads the last index page of a level
+#define SNAPSHOT_NO_PAGE 0xFFFFFFFF
+
+//Lots of save states in little memory, for searches that keep many similar states around. A state is cut into
+//fixed size pages and every distinct page is stored once with a reference count, found again by its hash. The
+//page ids of a state are paged and deduplicated the same way, level by level, so a state that only differs from
+//stored ones in a few pages costs those pages, the index pages above them and a few bytes of its own.
+//With a spill file, resident pages past the cap that weren't read recently are moved to a memory mapped file
+class SnapshotStore {
+public:
+	using Handle = uint32_t;
+
+private:
+	struct Page {
+		uint64_t hash;
+		uint32_t references; //0 while free
+		uint32_t slot; //in the resident pool or the spill file
+		bool spilled;
+		bool accessed; //since the clock hand last passed it
+		bool index; //holds page ids, never shared with a data page of the same bytes
+	};
+
+	struct State {
+		uint32_t size; //0 while free
+		uint8_t levels; //of index pages under the roots
+		uint8_t rootCount;
+		uint32_t roots[SNAPSHOT_ROOT_IDS];
+	};
+
+	std::vector<Page> pages;
+	std::vector<uint32_t> freePages;
+	//a page whose hash collides with a different one is stored without being findable
+	std::unordered_map<uint64_t, uint32_t> pageByHash;
+	std::vector<State> states;
+	std::vector<Handle> freeStates;
+
+	//resident pages in fixed chunks, so growing never copies or doubles them
+	std::vector<std::unique_ptr<Byte[]>> residentChunks;
+	std::vector<uint32_t> residentOwner; //page id in each resident slot
+	std::vector<uint32_t> freeResident;
+	size_t residentCap; //in slots
+	size_t clockHand = 0;
+
+	int spillFile = -1;
+	Byte* spillMap = nullptr;
+	size_t spillSlots = 0;
+	std::vector<uint32_t> freeSpilled;
+
+	//scratch for put and load
+	std::vector<Byte> stateBuffer;
+	std::vector<uint32_t> levelIds;
+	std::vector<uint32_t> aboveIds;
+
+	Byte* residentPage(uint32_t slot) const;
+	const Byte* pageData(uint32_t id);
+	//a reference to the page holding data, created is set if it wasn't stored yet
+	uint32_t intern(const Byte* data, bool index, bool& created);
+	void releasePage(uint32_t id, uint8_t level);
+	uint32_t residentSlot();
+	//moves one cold resident page to the spill file, false if there's none to move
+	bool evict();
+	uint32_t spillSlot();
+	void expand(uint32_t id, uint8_t level, Byte*& out, size_t& remaining);
+
+public:
+	//residentBytes of pages are kept in memory, past that they go to a file at spillPath, which is unlinked
+	//straight away and only lives as long as the store. Without a spill path everything stays in memory
+	explicit SnapshotStore(size_t residentBytes, const std::string& spillPath = {});
+	~SnapshotStore();
+	SnapshotStore(const SnapshotStore&) = delete;
+	SnapshotStore& operator=(const SnapshotStore&) = delete;
+
+	Handle put(std::span<const Byte> state);
+	Handle put(const GameBoy& gameboy);
+	//copies a state out, buffer has to hold size(handle) bytes
+	bool get(Handle handle, std::span<Byte> buffer);
+	bool load(Handle handle, GameBoy& gameboy);
+	void release(Handle handle);
+	size_t size(Handle handle) const;
+
+	size_t storedStates() const;
+	size_t uniquePages() const;
+	size_t residentBytes() const;
+	size_t spilledBytes() const;
+	//pages, their bookkeeping and the states, not counting the spill file
+	size_t memoryUsed() const;
+};
+
+#endif //GBPP_SRC_SNAPSHOTSTORE_HPP_
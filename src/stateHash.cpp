@@ -0,0 +1,164 @@
+#include "stateHash.hpp"
+#include <bit>
+#include <cstring>
+#include "gameboy.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define GBPP_X86_SIMD
+#include <immintrin.h>
+#endif
+
+#define HASH_STRIPE 32
+#define HASH_KEY_STEP 0x27D4EB2F165667C5ULL
+
+static constexpr uint64_t laneKeys[4] = {
+	0x9E3779B185EBCA87ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0x85EBCA77C2B2AE63ULL
+};
+
+//XXH3's accumulate step: each keyed word's halves multiplied into its own lane and the plain word added to
+//the neighbouring one. The keys move on every stripe so the same bytes elsewhere hash differently
+using Accumulator = void (*)(uint64_t* lanes, const Byte* data, size_t stripes, uint64_t* keys);
+
+static void accumulateScalar(uint64_t* lanes, const Byte* data, const size_t stripes, uint64_t* keys) {
+	for (size_t stripe = 0; stripe < stripes; stripe++) {
+		for (int lane = 0; lane < 4; lane++) {
+			uint64_t word;
+			std::memcpy(&word, data + stripe * HASH_STRIPE + lane * sizeof(word), sizeof(word));
+			const uint64_t keyed = word ^ keys[lane];
+			lanes[lane ^ 1] += word;
+			lanes[lane] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+		}
+		for (int lane = 0; lane < 4; lane++)
+			keys[lane] += HASH_KEY_STEP;
+	}
+}
+
+#ifdef GBPP_X86_SIMD
+__attribute__((target("avx2")))
+static void accumulateAVX2(uint64_t* lanes, const Byte* data, const size_t stripes, uint64_t* keys) {
+	__m256i accumulator = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+	__m256i key = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys));
+	const __m256i step = _mm256_set1_epi64x(static_cast<long long>(HASH_KEY_STEP));
+	for (size_t stripe = 0; stripe < stripes; stripe++) {
+		const __m256i word = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + stripe * HASH_STRIPE));
+		const __m256i keyed = _mm256_xor_si256(word, key);
+		const __m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+		//lane ^ 1
+		const __m256i swapped = _mm256_shuffle_epi32(word, _MM_SHUFFLE(1, 0, 3, 2));
+		accumulator = _mm256_add_epi64(accumulator, _mm256_add_epi64(product, swapped));
+		key = _mm256_add_epi64(key, step);
+	}
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), accumulator);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(keys), key);
+}
+#endif
+
+static Accumulator selectAccumulator() {
+#ifdef GBPP_X86_SIMD
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return accumulateAVX2;
+#endif
+	return accumulateScalar;
+}
+
+static uint64_t avalanche(uint64_t hash) {
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33;
+	hash *= 0xC4CEB9FE1A85EC53ULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+StateHash hashBytes(const Byte* data, const size_t size, const uint64_t seed) {
+	static const Accumulator accumulate = selectAccumulator();
+	uint64_t lanes[4];
+	uint64_t keys[4];
+	for (int lane = 0; lane < 4; lane++) {
+		lanes[lane] = laneKeys[lane] + seed;
+		keys[lane] = laneKeys[3 - lane];
+	}
+	const size_t stripes = size / HASH_STRIPE;
+	accumulate(lanes, data, stripes, keys);
+	//the rest zero padded, the size tells it apart from real zeros
+	if (const size_t rest = size % HASH_STRIPE) {
+		Byte last[HASH_STRIPE] = {};
+		std::memcpy(last, data + stripes * HASH_STRIPE, rest);
+		accumulate(lanes, last, 1, keys);
+	}
+	return {
+		avalanche(lanes[0] ^ std::rotl(lanes[1], 19) ^ std::rotl(lanes[2], 37) ^ std::rotl(lanes[3], 53) ^ size),
+		avalanche(lanes[2] + std::rotl(lanes[3], 19) + std::rotl(lanes[0], 37) + std::rotl(lanes[1], 53) + size)
+	};
+}
+
+size_t AddressSpace::ramPages() const {
+	return BLOCK_PAGES + cartridgeRamGenerations.size();
+}
+
+const Byte* AddressSpace::ramPage(size_t index) const {
+	if (index < (VRAM_SIZE >> 8))
+		return vramBlock.get() + (index << 8);
+	index -= VRAM_SIZE >> 8;
+	if (index < BLOCK_PAGES - (VRAM_SIZE >> 8))
+		return workRamBlocks[index / (WORK_RAM_BANK_SIZE >> 8)].get() + ((index % (WORK_RAM_BANK_SIZE >> 8)) << 8);
+	index -= BLOCK_PAGES - (VRAM_SIZE >> 8);
+	const size_t bankPages = cartridgeRamBankSize >> 8;
+	return cartridgeRamBanks[index / bankPages].get() + ((index % bankPages) << 8);
+}
+
+void AddressSpace::updateRamHash(const uint32_t* generations, const size_t first, const size_t count) const {
+	for (size_t page = first; page < first + count; page++) {
+		const uint32_t generation = generations[page - first];
+		if (hashedGenerations[page] == generation)
+			continue;
+		const StateHash hash = hashBytes(ramPage(page), 0x100, page);
+		ramHash.low += hash.low - pageHashes[page].low;
+		ramHash.high += hash.high - pageHashes[page].high;
+		pageHashes[page] = hash;
+		hashedGenerations[page] = generation;
+	}
+}
+
+void AddressSpace::hashState(StateWriter& state) const {
+	const size_t pages = ramPages();
+	if (pageHashes.size() != pages) {
+		//a different cartridge, every page is hashed again
+		pageHashes.assign(pages, {});
+		hashedGenerations.resize(pages);
+		ramHash = {};
+		for (size_t page = 0; page < BLOCK_PAGES; page++)
+			hashedGenerations[page] = blockGenerations[page] - 1;
+		for (size_t page = BLOCK_PAGES; page < pages; page++)
+			hashedGenerations[page] = cartridgeRamGenerations[page - BLOCK_PAGES] - 1;
+	}
+	//most pages weren't written since the last call, a compare of each run finds out quicker than the loop
+	if (std::memcmp(hashedGenerations.data(), blockGenerations, sizeof(blockGenerations)) != 0)
+		updateRamHash(blockGenerations, 0, BLOCK_PAGES);
+	const size_t cartridgePages = cartridgeRamGenerations.size();
+	if (cartridgePages && std::memcmp(hashedGenerations.data() + BLOCK_PAGES, cartridgeRamGenerations.data(),
+	                                  cartridgePages * sizeof(uint32_t)) != 0)
+		updateRamHash(cartridgeRamGenerations.data(), BLOCK_PAGES, cartridgePages);
+
+	state.field(ramHash);
+	state.field(bootromLoaded);
+	state.field(mbcController->saveState());
+	//OAM through IE
+	const Byte* registers = memoryLayout.oam;
+	state.bytes(registers, &memoryLayout.IE + 1 - registers);
+}
+
+StateHash GameBoy::stateHash() const {
+	//the same size every time
+	if (stateHashFields.empty()) {
+		StateWriter counter;
+		transferState(counter, *this);
+		addressSpace.hashState(counter);
+		stateHashFields.resize(counter.written());
+	}
+	StateWriter state(stateHashFields.data());
+	transferState(state, *this);
+	addressSpace.hashState(state);
+	return hashBytes(stateHashFields.data(), stateHashFields.size(), readOnlyAddressSpace.romHash);
+}
@@ -0,0 +1,20 @@
+#ifndef GBPP_SRC_STATEHASH_HPP_
+#define GBPP_SRC_STATEHASH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include "defines.hpp"
+
+//128 bits, either half alone does as a 64 bit hash
+struct StateHash {
+	uint64_t low;
+	uint64_t high;
+
+	bool operator==(const StateHash&) const = default;
+};
+
+//Four 64 bit lanes over 32 byte stripes, so it runs a stripe per step with AVX2. Every path gives the same
+//result, hashes can be compared between machines. Fast rather than strong, nothing here is adversarial
+StateHash hashBytes(const Byte* data, size_t size, uint64_t seed = 0);
+
+#endif //GBPP_SRC_STATEHASH_HPP_
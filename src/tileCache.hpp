@@ -0,0 +1,73 @@
+#ifndef GBPP_SRC_TILECACHE_HPP_
+#define GBPP_SRC_TILECACHE_HPP_
+
+#include <array>
+#include <bit>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include "defines.hpp"
+
+#define TILE_COUNT 384 //0x8000-0x97FF, 16 bytes each
+
+static_assert(std::endian::native == std::endian::little, "tile rows are decoded as little endian words");
+
+//VRAM tile data decoded from 2bpp bit planes into one colour index (0-3) per pixel. A tile is only decoded
+//again the first time it's used after a write to it
+class TileCache {
+	std::array<std::array<Byte, 64>, TILE_COUNT> tiles = {};
+	std::bitset<TILE_COUNT> dirty;
+	//bumped on every write to a tile, for anything keyed on tile contents
+	std::array<uint32_t, TILE_COUNT> generations = {};
+
+	//each bit of a bit plane moved to the low bit of its own byte, bit 7 (the leftmost pixel) in the first byte
+	static constexpr std::array<uint64_t, 256> spreadBits = [] {
+		std::array<uint64_t, 256> table = {};
+		for (int plane = 0; plane < 256; plane++) {
+			for (int x = 0; x < 8; x++)
+				table[plane] |= static_cast<uint64_t>((plane >> (7 - x)) & 1) << (x * 8);
+		}
+		return table;
+	}();
+
+	//a whole row of 8 indices a time from its two bit planes
+	void decode(const Byte* vram, const uint16_t tile) {
+		const Byte* data = vram + tile * 16;
+		for (int y = 0; y < 8; y++) {
+			const uint64_t row = spreadBits[data[y * 2]] | spreadBits[data[y * 2 + 1]] << 1;
+			std::memcpy(&tiles[tile][y * 8], &row, sizeof(row));
+		}
+		dirty.reset(tile);
+	}
+
+public:
+	TileCache() {
+		dirty.set();
+	}
+
+	//address is 0x8000 based
+	void invalidate(const Word address) {
+		const uint16_t tile = (address - 0x8000) >> 4;
+		dirty.set(tile);
+		generations[tile]++;
+	}
+
+	void invalidateAll() {
+		dirty.set();
+		for (uint32_t& generation : generations)
+			generation++;
+	}
+
+	uint32_t generation(const uint16_t tile) const {
+		return generations[tile];
+	}
+
+	//8 colour indices, leftmost pixel first. tile is 0-383 counting from 0x8000
+	const Byte* row(const Byte* vram, const uint16_t tile, const uint8_t y) {
+		if (dirty.test(tile))
+			decode(vram, tile);
+		return &tiles[tile][y * 8];
+	}
+};
+
+#endif //GBPP_SRC_TILECACHE_HPP_
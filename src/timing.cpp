@@ -6,13 +6,51 @@ void GameBoy::timingHandler() {
 	//addressSpace.memoryLayout.DIV = ((cycles / 4) >> 6) & 0xFF;
 
 	if (cycles - lastDivUpdate >= DIVIDER_REGISTER_FREQ) {
-		const uint8_t increments = (cycles - lastDivUpdate) / DIVIDER_REGISTER_FREQ;
+		//can be a lot more than 255 since the last catch up, DIV just wraps
+		const uint64_t increments = (cycles - lastDivUpdate) / DIVIDER_REGISTER_FREQ;
 		addressSpace.memoryLayout.DIV += increments;
 		lastDivUpdate += increments * DIVIDER_REGISTER_FREQ;
 	}
 
 	//if enabled
-	uint64_t TIMAFrequency = 0;
+	if (TIMAFrequency) {
+		//if TIMA overflowed and prevTMA != current TMA, use prevTMA (ie use prevTMA regardless)
+		const int increments = (cycles - lastTIMAUpdate) / TIMAFrequency;
+		if (cycles - lastTIMAUpdate >= TIMAFrequency) {
+			if (static_cast<int>(addressSpace.memoryLayout.TIMA) + increments > 255) {
+				addressSpace.memoryLayout.TIMA = prevTMA + ((addressSpace.memoryLayout.TIMA + increments) % 256);
+				setInterrupt(TIMER_INTERRUPT);
+			}
+			else
+				addressSpace.memoryLayout.TIMA += increments;
+			lastTIMAUpdate += increments * TIMAFrequency;
+		}
+	}
+	scheduleTimer();
+}
+
+//DIV and TIMA are caught up lazily on access, the only thing that needs an event is TIMA overflowing
+void GameBoy::scheduleTimer() {
+	if (TIMAFrequency)
+		scheduler.schedule(timerEvent,
+		                   lastTIMAUpdate + (256 - addressSpace.memoryLayout.TIMA) * static_cast<uint64_t>(TIMAFrequency));
+	else
+		scheduler.cancel(timerEvent);
+}
+
+void GameBoy::DIVWrite() {
+	//the divider itself was already cleared by the write
+	lastDivUpdate = cycles;
+}
+
+void GameBoy::TMAWrite() {
+	//service at the end of this instruction so prevTMA picks up the new value
+	scheduler.schedule(timerEvent, cycles);
+}
+
+void GameBoy::TACWrite() {
+	const bool wasEnabled = TIMAFrequency;
+	TIMAFrequency = 0;
 	if (addressSpace.memoryLayout.TAC & 0x04) {
 		switch (addressSpace.memoryLayout.TAC & 0x03) {
 		case 0:
@@ -28,16 +66,9 @@ void GameBoy::timingHandler() {
 			TIMAFrequency = 256;
 			break;
 		}
-		//if TIMA overflowed and prevTMA != current TMA, use prevTMA (ie use prevTMA regardless)
-		const int increments = (cycles - lastTIMAUpdate) / TIMAFrequency;
-		if (cycles - lastTIMAUpdate >= TIMAFrequency) {
-			if (static_cast<int>(addressSpace.memoryLayout.TIMA) + increments > 255) {
-				addressSpace.memoryLayout.TIMA = prevTMA + ((addressSpace.memoryLayout.TIMA + increments) % 256);
-				setInterrupt(TIMER_INTERRUPT);
-			}
-			else
-				addressSpace.memoryLayout.TIMA += increments;
-			lastTIMAUpdate += increments * TIMAFrequency;
-		}
 	}
+	//start counting from now rather than catching up on the time spent stopped
+	if (!wasEnabled)
+		lastTIMAUpdate = cycles;
+	scheduleTimer();
 }
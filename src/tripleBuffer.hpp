@@ -0,0 +1,44 @@
+#ifndef GBPP_SRC_TRIPLEBUFFER_HPP_
+#define GBPP_SRC_TRIPLEBUFFER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//Hands values from one producer thread to one consumer thread without locks. The producer fills back() and
+//publish()es it, the consumer acquire()s the newest published value as front(). Neither side ever waits for
+//the other, a value the consumer doesn't get to in time is replaced by the next one
+template <typename T>
+class TripleBuffer {
+	//set on the shared index while it holds a value the consumer hasn't acquired
+	static constexpr uint8_t fresh = 0x4;
+
+	std::array<T, 3> buffers = {};
+	uint8_t backIndex = 0;
+	std::atomic<uint8_t> middleIndex = 1;
+	uint8_t frontIndex = 2;
+
+public:
+	//producer side
+	T& back() {
+		return buffers[backIndex];
+	}
+
+	void publish() {
+		backIndex = middleIndex.exchange(backIndex | fresh, std::memory_order_acq_rel) & 0x3;
+	}
+
+	//consumer side, false if nothing new was published since the last acquire
+	bool acquire() {
+		if (!(middleIndex.load(std::memory_order_relaxed) & fresh))
+			return false;
+		frontIndex = middleIndex.exchange(frontIndex, std::memory_order_acq_rel) & 0x3;
+		return true;
+	}
+
+	const T& front() const {
+		return buffers[frontIndex];
+	}
+};
+
+#endif //GBPP_SRC_TRIPLEBUFFER_HPP_
@@ -0,0 +1,38 @@
+#include "testRunner.hpp"
+
+//fork() against plain copies made through save states
+void runForkTests(const TestGame& game, TestResults& results) {
+	auto parent = loadedGameBoy(game);
+	runFrames(*parent, 0, 120);
+	const std::vector<Byte> forked = savedState(*parent);
+	auto child = parent->fork();
+	results.expect(savedState(*child) == forked, "a fork starts from its parent's state");
+
+	runFrames(*child, 120, 100, 1);
+	results.expect(savedState(*parent) == forked, "a child running 100 frames leaves the parent byte-identical");
+	auto childReference = loadedGameBoy(game);
+	childReference->loadState(forked);
+	runFrames(*childReference, 120, 100, 1);
+	results.expect(savedState(*child) == savedState(*childReference), "a child runs the same as a loaded copy");
+
+	auto grandchild = child->fork();
+	const std::vector<Byte> childState = savedState(*child);
+	auto reference = loadedGameBoy(game);
+	reference->loadState(forked);
+	runFrames(*parent, 120, 100);
+	runFrames(*reference, 120, 100);
+	results.expect(savedState(*parent) == savedState(*reference), "a parent runs the same as if it was never forked");
+
+	runFrames(*grandchild, 220, 50, 2);
+	results.expect(savedState(*child) == childState, "a fork of a fork leaves its parent alone");
+	//the blocks the parent still shared stay with the child
+	parent.reset();
+	runFrames(*child, 220, 50, 2);
+	results.expect(savedState(*child) == savedState(*grandchild), "a child outlives its parent");
+
+	auto sibling = reference->fork();
+	const std::vector<Byte> referenceState = savedState(*reference);
+	sibling->loadState(childState);
+	results.expect(savedState(*reference) == referenceState && savedState(*sibling) == childState,
+	               "loading into a fork leaves its parent alone");
+}
@@ -0,0 +1,47 @@
+#include <algorithm>
+#include "rewindBuffer.hpp"
+#include "testRunner.hpp"
+
+//rewinding against the states and frames recorded on the way
+void runRewindBufferTests(const TestGame& game, TestResults& results) {
+	auto gameboy = loadedGameBoy(game);
+	//16 snapshots 8 frames apart, so 400 frames reach past it
+	RewindBuffer rewind(1 << 20, 16, 8);
+	//states[frame] is the state that frame started from, framebuffers[frame] what it drew
+	std::vector<std::vector<Byte>> states;
+	std::vector<std::vector<Byte>> framebuffers;
+	const auto record = [&](const uint64_t frames, const uint64_t seed) {
+		for (uint64_t i = 0; i < frames; i++) {
+			const uint64_t frame = states.size();
+			states.push_back(savedState(*gameboy));
+			rewind.record(*gameboy, testInput(frame, seed));
+			runFrames(*gameboy, frame, 1, seed);
+			const auto framebuffer = gameboy->getFramebuffer();
+			framebuffers.emplace_back(framebuffer.begin(), framebuffer.end());
+		}
+	};
+	//lands on the state the target frame started from, showing the frame before it
+	const auto rewindTo = [&](const uint64_t frames) {
+		const size_t target = states.size() - std::min<uint64_t>(frames, rewind.depth());
+		const bool landed = rewind.rewind(*gameboy, frames) && savedState(*gameboy) == states[target] &&
+			std::ranges::equal(gameboy->getFramebuffer(), framebuffers[target - 1]);
+		states.resize(target);
+		framebuffers.resize(target);
+		return landed;
+	};
+
+	record(400, 0);
+	bool same = true;
+	for (const uint64_t frames : {1, 7, 50, 60})
+		same &= rewindTo(frames);
+	results.expect(same, "rewinding lands on the recorded state and frame");
+
+	//a different branch from there
+	record(100, 3);
+	results.expect(rewindTo(30), "rewinding after a branch");
+
+	const uint64_t depth = rewind.depth();
+	results.expect(depth > 0 && depth < 8 * 16, "the depth stays within the snapshots kept");
+	results.expect(rewindTo(1000), "rewinding past the depth stops a frame after the oldest snapshot");
+	results.expect(rewind.depth() == 0 && rewindTo(1), "rewinding with nothing further back redraws the frame");
+}
@@ -0,0 +1,45 @@
+#include <algorithm>
+#include <span>
+#include "testRunner.hpp"
+
+//save and load against the instance that was saved
+void runSaveStateTests(const TestGame& game, TestResults& results) {
+	auto gameboy = loadedGameBoy(game);
+	runFrames(*gameboy, 0, 120);
+	const std::vector<Byte> saved = savedState(*gameboy);
+	auto restored = loadedGameBoy(game);
+	results.expect(restored->loadState(saved) && savedState(*restored) == saved, "save/load round trip");
+
+	bool same = true;
+	for (uint64_t frame = 120; frame < 240; frame++) {
+		runFrames(*gameboy, frame, 1);
+		runFrames(*restored, frame, 1);
+		same &= savedState(*gameboy) == savedState(*restored) &&
+			std::ranges::equal(gameboy->getFramebuffer(), restored->getFramebuffer());
+	}
+	results.expect(same, "a loaded state runs and draws the same as the one saved");
+
+	runFrames(*restored, 240, 60, 1);
+	restored->loadState(saved);
+	runFrames(*restored, 120, 120);
+	results.expect(savedState(*restored) == savedState(*gameboy), "loading over a running instance");
+
+	std::vector<Byte> corrupt = saved;
+	corrupt[0] ^= 1;
+	results.expect(!restored->loadState(corrupt), "a state with a bad header is refused");
+	results.expect(!restored->loadState(std::span(saved).first(saved.size() - 1)), "a truncated state is refused");
+
+	//the render policy stays with the instance
+	auto onRequest = loadedGameBoy(game);
+	onRequest->setRenderPolicy(renderOnRequest);
+	onRequest->loadState(saved);
+	runFrames(*onRequest, 120, 1);
+	results.expect(!onRequest->frameDrawn(), "a loaded state doesn't draw without a request");
+	onRequest->requestRender();
+	onRequest->loadState(saved);
+	onRequest->loadState(saved);
+	runFrames(*onRequest, 120, 1);
+	const bool requestedFrame = onRequest->frameDrawn();
+	runFrames(*onRequest, 121, 1);
+	results.expect(requestedFrame && !onRequest->frameDrawn(), "loading keeps a render request for one frame");
+}
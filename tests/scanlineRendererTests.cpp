@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <random>
+#include "scanlineRenderer.hpp"
+#include "testRunner.hpp"
+
+static constexpr PixelFormat pixelFormats[] = {pixelARGB8888, pixelRGB565, pixelGray8, pixelShade8, pixelShade2};
+static constexpr const char* formatNames[] = {"ARGB8888", "RGB565", "Gray8", "Shade8", "Shade2"};
+
+//shades 0 (white) to 3 (black) in each format
+static constexpr uint32_t knownShades[][4] = {
+	{0xFFFFFFFF, 0xFFAAAAAA, 0xFF555555, 0xFF000000},
+	{0xFFFF, 0xAD55, 0x52AA, 0x0000},
+	{0xFF, 0xAA, 0x55, 0x00},
+	{0, 1, 2, 3},
+	{0, 1, 2, 3}
+};
+
+//known pixels in every format, then every composer the CPU supports against the scalar one on the same random
+//lines, byte for byte
+void runScanlineRendererTests(TestResults& results) {
+	const std::vector<NamedComposer> composers = supportedScanlineComposers();
+
+	//a line of shades 0 1 2 3 over and over through BGP, with no objects
+	Byte shades[RESOLUTION_X];
+	const Byte noObjects[RESOLUTION_X] = {};
+	for (int x = 0; x < RESOLUTION_X; x++)
+		shades[x] = x % 4;
+	for (size_t format = 0; format < std::size(pixelFormats); format++) {
+		uint32_t palette[16] = {};
+		bool known = true;
+		for (Byte shade = 0; shade < 4; shade++) {
+			palette[shade] = shadeToPixel(shade, pixelFormats[format]);
+			known &= palette[shade] == knownShades[format][shade];
+		}
+		results.expect(known, std::string(formatNames[format]) + " shades");
+
+		const int rowBytes = scanlineBytes(pixelFormats[format]);
+		Byte expected[RESOLUTION_X * 4];
+		if (pixelFormats[format] == pixelShade2) {
+			//leftmost pixel in the top bits
+			std::fill_n(expected, rowBytes, 0x1B);
+		}
+		else {
+			//little endian pixels
+			const int pixelBytes = rowBytes / RESOLUTION_X;
+			for (int x = 0; x < RESOLUTION_X; x++) {
+				for (int byte = 0; byte < pixelBytes; byte++)
+					expected[x * pixelBytes + byte] = knownShades[format][x % 4] >> (byte * 8);
+			}
+		}
+		for (const NamedComposer& composer : composers) {
+			Byte out[RESOLUTION_X * 4];
+			composer.compose(shades, noObjects, palette, pixelFormats[format], out);
+			results.expect(std::equal(out, out + rowBytes, expected),
+			               std::string(composer.name) + " composes known " + formatNames[format] + " pixels");
+		}
+	}
+
+	std::mt19937 random(12);
+	for (size_t format = 0; format < std::size(pixelFormats); format++) {
+		const int rowBytes = scanlineBytes(pixelFormats[format]);
+		std::vector<bool> same(composers.size(), true);
+		for (int line = 0; line < 4000; line++) {
+			Byte bg[RESOLUTION_X];
+			Byte obj[RESOLUTION_X];
+			for (int x = 0; x < RESOLUTION_X; x++) {
+				bg[x] = random() & 0x03;
+				obj[x] = random() & (0x03 | OBJ_LINE_PALETTE | OBJ_LINE_BG_OVER_OBJ);
+			}
+			//BGP, OBP0 and OBP1 entries as the PPU builds them, ARGB8888 also with arbitrary colours
+			uint32_t palette[16];
+			const bool arbitrary = pixelFormats[format] == pixelARGB8888 && line % 2;
+			for (uint32_t& entry : palette)
+				entry = arbitrary ? random() : shadeToPixel(random() & 0x03, pixelFormats[format]);
+
+			Byte expected[RESOLUTION_X * 4];
+			composeScanlineScalar(bg, obj, palette, pixelFormats[format], expected);
+			for (size_t composer = 1; composer < composers.size(); composer++) {
+				Byte out[RESOLUTION_X * 4];
+				composers[composer].compose(bg, obj, palette, pixelFormats[format], out);
+				same[composer] = same[composer] && std::equal(out, out + rowBytes, expected);
+			}
+		}
+		for (size_t composer = 1; composer < composers.size(); composer++)
+			results.expect(same[composer], std::string(composers[composer].name) + " composes " + formatNames[format] +
+			               " like the scalar version");
+	}
+}
@@ -0,0 +1,42 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include "3rdParty/json.hpp"
+#include "testing.hpp"
+#include "testRunner.hpp"
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+static GameboyTestState testState(const json& state) {
+	std::vector<std::tuple<Word, Byte>> ram;
+	for (const auto& entry : state["ram"])
+		ram.emplace_back(entry[0], entry[1]);
+	return {
+		state["pc"], state["sp"], state["a"], state["f"], state["b"], state["c"], state["d"], state["e"], state["h"],
+		state["l"], ram
+	};
+}
+
+//the jsmoo SM83 JSON tests, one check per file that stops at the first case that fails
+void runSM83Tests(const std::string& directory, TestResults& results) {
+	std::vector<fs::path> testFiles;
+	for (const auto& entry : fs::directory_iterator(directory))
+		testFiles.emplace_back(entry.path());
+	std::ranges::sort(testFiles);
+	results.expect(!testFiles.empty(), "SM83 test files in " + directory);
+
+	auto gameboy = std::make_unique<GameBoy>();
+	for (const auto& testFile : testFiles) {
+		std::ifstream file(testFile);
+		const json tests = json::parse(file);
+		bool passed = true;
+		for (const auto& test : tests) {
+			if (gameboy->runTest(testState(test["initial"])) != testState(test["final"])) {
+				passed = false;
+				break;
+			}
+		}
+		results.expect(passed, testFile.string());
+	}
+}
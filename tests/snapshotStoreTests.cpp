@@ -0,0 +1,45 @@
+#include <filesystem>
+#include "snapshotStore.hpp"
+#include "testRunner.hpp"
+
+//the store against the states put into it, with a small cap so pages spill
+void runSnapshotStoreTests(const TestGame& game, TestResults& results) {
+	const std::filesystem::path spill = std::filesystem::temp_directory_path() / "gbpp_tests.spill";
+	SnapshotStore store(64 << 10, spill.string());
+	auto gameboy = loadedGameBoy(game);
+	std::vector<SnapshotStore::Handle> handles;
+	std::vector<std::vector<Byte>> states;
+	for (uint64_t frame = 0; frame < 200; frame++) {
+		runFrames(*gameboy, frame, 1);
+		handles.push_back(store.put(*gameboy));
+		states.push_back(savedState(*gameboy));
+	}
+	const size_t pages = store.uniquePages();
+	handles.push_back(store.put(states.back()));
+	states.push_back(states.back());
+	results.expect(store.uniquePages() == pages, "a stored state again adds no pages");
+
+	bool same = true;
+	std::vector<Byte> buffer;
+	for (size_t i = 0; i < handles.size(); i++) {
+		buffer.resize(store.size(handles[i]));
+		same &= store.get(handles[i], buffer) && buffer == states[i];
+	}
+	results.expect(same, "every stored state comes back as it was put");
+	auto loaded = loadedGameBoy(game);
+	results.expect(store.load(handles[50], *loaded) && savedState(*loaded) == states[50], "loading from the store");
+
+	//odd handles first so shared pages are released from both sides
+	for (size_t i = 1; i < handles.size(); i += 2)
+		store.release(handles[i]);
+	same = true;
+	for (size_t i = 0; i < handles.size(); i += 2) {
+		buffer.resize(store.size(handles[i]));
+		same &= store.get(handles[i], buffer) && buffer == states[i];
+	}
+	results.expect(same, "releasing some states leaves the others intact");
+	for (size_t i = 0; i < handles.size(); i += 2)
+		store.release(handles[i]);
+	results.expect(store.storedStates() == 0 && store.uniquePages() == 0 && store.residentBytes() == 0 &&
+	               store.spilledBytes() == 0, "releasing every handle frees every page");
+}
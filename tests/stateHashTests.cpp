@@ -0,0 +1,52 @@
+#include "testRunner.hpp"
+
+//the incremental hash against one worked out from scratch by an instance that only just loaded the state
+void runStateHashTests(const TestGame& game, TestResults& results) {
+	auto gameboy = loadedGameBoy(game);
+	auto skipping = loadedGameBoy(game);
+	skipping->setRenderPolicy(renderEveryNth, 3);
+	bool incremental = true;
+	bool policy = true;
+	for (uint64_t frame = 0; frame < 300; frame++) {
+		//stopping mid frame as well
+		for (GameBoy* instance : {gameboy.get(), skipping.get()}) {
+			runFrames(*instance, frame, 1);
+			instance->runCycles(frame * 37 % 500);
+		}
+		const StateHash hash = gameboy->stateHash();
+		auto fresh = loadedGameBoy(game);
+		fresh->loadState(savedState(*gameboy));
+		incremental &= fresh->stateHash() == hash;
+		policy &= skipping->stateHash() == hash;
+	}
+	results.expect(incremental, "the incremental hash equals one from scratch");
+	results.expect(policy, "the hash doesn't depend on the render policy");
+
+	std::vector<Byte> changed = savedState(*gameboy);
+	//RAM whatever the cartridge
+	changed[changed.size() - 600] ^= 1;
+	auto other = loadedGameBoy(game);
+	other->loadState(changed);
+	results.expect(!(other->stateHash() == gameboy->stateHash()), "one changed bit changes the hash");
+	//gameboy has hashed its pages before, the load has to make it hash them again
+	gameboy->loadState(changed);
+	results.expect(gameboy->stateHash() == other->stateHash(), "a load is rehashed");
+
+	//a fork takes its parent's page hashes along
+	auto child = gameboy->fork();
+	results.expect(child->stateHash() == gameboy->stateHash(), "a fork hashes the same as its parent");
+	runFrames(*child, 300, 100, 1);
+	auto childReference = loadedGameBoy(game);
+	childReference->loadState(savedState(*child));
+	results.expect(child->stateHash() == childReference->stateHash(), "a child's hash follows its writes");
+	//a fork's first write to each block goes through the copy, checked one instruction at a time
+	auto stepped = childReference->fork();
+	auto rehashed = loadedGameBoy(game);
+	bool firstWrites = true;
+	for (int instruction = 0; instruction < 5000; instruction++) {
+		stepped->step();
+		rehashed->loadState(savedState(*stepped));
+		firstWrites &= stepped->stateHash() == rehashed->stateHash();
+	}
+	results.expect(firstWrites, "a fork's hash follows its first writes");
+}
@@ -0,0 +1,72 @@
+#include "testRunner.hpp"
+#include <iostream>
+
+void TestResults::expect(const bool passed, const std::string& name) {
+	checks++;
+	if (!passed) {
+		std::cout << "Test " << name << " failed!" << std::endl;
+		failed++;
+	}
+}
+
+bool TestResults::report() const {
+	if (!failed)
+		std::cout << "Success! " << checks << " checks" << std::endl;
+	else
+		std::cout << failed << "/" << checks << " failed!" << std::endl;
+	return !failed;
+}
+
+std::unique_ptr<GameBoy> loadedGameBoy(const TestGame& game) {
+	auto gameboy = std::make_unique<GameBoy>();
+	gameboy->loadBootrom(game.bootrom);
+	gameboy->loadGame(game.game);
+	return gameboy;
+}
+
+std::vector<Byte> savedState(const GameBoy& gameboy) {
+	std::vector<Byte> state(gameboy.saveStateSize());
+	gameboy.saveState(state);
+	return state;
+}
+
+Input testInput(const uint64_t frame, const uint64_t seed) {
+	const uint64_t bits = (frame / 4 + seed * 0x100) * 0x9E3779B97F4A7C15ULL >> 56;
+	return {
+		static_cast<bool>(bits & 0x01), static_cast<bool>(bits & 0x02), static_cast<bool>(bits & 0x04),
+		static_cast<bool>(bits & 0x08), static_cast<bool>(bits & 0x10), static_cast<bool>(bits & 0x20), false, false
+	};
+}
+
+void runFrames(GameBoy& gameboy, const uint64_t first, const uint64_t frames, const uint64_t seed) {
+	for (uint64_t frame = first; frame < first + frames; frame++) {
+		gameboy.setInput(testInput(frame, seed));
+		gameboy.runFrame();
+	}
+}
+
+int main(int argc, char** argv) {
+	TestResults results;
+	const std::string suite = argc > 1 ? argv[1] : "";
+	if (suite == "composers" && argc == 2) {
+		runScanlineRendererTests(results);
+	}
+	else if (suite == "sm83" && argc == 3) {
+		runSM83Tests(argv[2], results);
+	}
+	else if (suite == "game" && argc == 4) {
+		const TestGame game = {argv[2], argv[3]};
+		runSaveStateTests(game, results);
+		runForkTests(game, results);
+		runRewindBufferTests(game, results);
+		runSnapshotStoreTests(game, results);
+		runStateHashTests(game, results);
+	}
+	else {
+		std::cerr << "Usage: " << argv[0] << " composers\n"
+			<< "       " << argv[0] << " sm83 <test directory>\n"
+			<< "       " << argv[0] << " game <bios> <game>" << std::endl;
+		return 1;
+	}
+	return results.report() ? 0 : 1;
+}
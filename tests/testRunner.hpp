@@ -0,0 +1,42 @@
+#ifndef GBPP_TESTS_TESTRUNNER_HPP_
+#define GBPP_TESTS_TESTRUNNER_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "defines.hpp"
+#include "gameboy.hpp"
+
+//counts checks and prints the ones that fail
+class TestResults {
+	int checks = 0;
+	int failed = 0;
+
+public:
+	void expect(bool passed, const std::string& name);
+	//prints the totals, true if nothing failed
+	bool report() const;
+};
+
+//the bootrom and game the checks that run a real program use, any game that runs will do
+struct TestGame {
+	std::string bootrom;
+	std::string game;
+};
+
+std::unique_ptr<GameBoy> loadedGameBoy(const TestGame& game);
+std::vector<Byte> savedState(const GameBoy& gameboy);
+//the same presses for the same frame and seed, so runs can be repeated
+Input testInput(uint64_t frame, uint64_t seed);
+void runFrames(GameBoy& gameboy, uint64_t first, uint64_t frames, uint64_t seed = 0);
+
+void runSM83Tests(const std::string& directory, TestResults& results);
+void runScanlineRendererTests(TestResults& results);
+void runSaveStateTests(const TestGame& game, TestResults& results);
+void runForkTests(const TestGame& game, TestResults& results);
+void runRewindBufferTests(const TestGame& game, TestResults& results);
+void runSnapshotStoreTests(const TestGame& game, TestResults& results);
+void runStateHashTests(const TestGame& game, TestResults& results);
+
+#endif //GBPP_TESTS_TESTRUNNER_HPP_